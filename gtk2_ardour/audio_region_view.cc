@@ -37,6 +37,7 @@
 #include "ardour/audiosource.h"
 #include "ardour/profile.h"
 #include "ardour/session.h"
+#include "ardour/source_factory.h"
 
 #include "pbd/memento_command.h"
 #include "pbd/stacktrace.h"
@@ -1223,6 +1224,7 @@ AudioRegionView::create_waves ()
 				// cerr << "\tdata is not ready for channel " << n << "\n";
 				// we'll get a PeaksReady signal from the source in the future
 				// and will call create_one_wave(n) then.
+				SourceFactory::prioritize_peakfile (audio_region()->audio_source(n));
 				pending_peak_data->show ();
 			}
 
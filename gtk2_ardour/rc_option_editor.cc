@@ -2320,6 +2320,16 @@ RCOptionEditor::RCOptionEditor ()
 		procs->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
 
 		add_option (_("General"), procs);
+
+		bo = new BoolOption (
+				"intra-route-parallelism",
+				_("Process independent sends of a track or bus in parallel"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_intra_route_parallelism),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_intra_route_parallelism)
+				);
+		Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+				_("When enabled, consecutive sends of a track or bus are distributed over the available DSP threads."));
+		add_option (_("General"), bo);
 	}
 
 	/* Image cache size */
@@ -2987,6 +2997,16 @@ RCOptionEditor::RCOptionEditor ()
 
 	add_option (_("Audio"), new BufferingOptions (_rc_config));
 
+	bo = new BoolOption (
+		     "mmap-audio-files",
+		     _("Memory-map uncompressed audio files"),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::get_mmap_audio_files),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_mmap_audio_files)
+		     );
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+			_("When enabled, WAV, RF64 and CAF files with 16, 24 bit integer or 32 bit float samples are read directly from the page-cache. Do not enable this if external files may be modified while in use."));
+	add_option (_("Audio"), bo);
+
 	add_option (_("Audio"), new OptionEditorHeading (_("Denormals")));
 
 	add_option (_("Audio"),
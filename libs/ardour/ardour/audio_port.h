@@ -56,11 +56,18 @@ protected:
 	/* special access for PortManager only (hah, C++) */
 	Sample* engine_get_whole_audio_buffer ();
 
+	/* input resampling, used by PortManager::cycle_start instead of
+	 * ::cycle_start() for externally connected input ports */
+	Sample const* engine_get_input_buffer (pframes_t nframes);
+	void resample_input (Sample const* src, pframes_t nframes);
+	void share_resampled_input (AudioPort const& other);
+
 private:
 	AudioBuffer*            _buffer;
 	ArdourZita::VMResampler _src;
 	Sample*                 _data;
 	bool                    _buf_valid;
+	bool                    _src_idle;
 };
 
 } // namespace ARDOUR
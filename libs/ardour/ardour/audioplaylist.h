@@ -45,6 +45,11 @@ public:
 
 	samplecnt_t read (Sample *dst, Sample *mixdown, float *gain_buffer, samplepos_t start, samplecnt_t cnt, uint32_t chan_n=0);
 
+	/** Submit asynchronous read-ahead for all regions and channels
+	 * of the given range, before reading it one channel at a time.
+	 */
+	void prefetch (samplepos_t start, samplecnt_t cnt);
+
 	bool destroy_region (boost::shared_ptr<Region>);
 
 protected:
@@ -53,7 +58,36 @@ protected:
 	void post_combine (std::vector<boost::shared_ptr<Region> >&, boost::shared_ptr<Region>);
 	void pre_uncombine (std::vector<boost::shared_ptr<Region> >&, boost::shared_ptr<Region>);
 
+	void invalidate_playback_map ();
+
 private:
+	/** Part of a region which is audible after layering */
+	struct PlaybackSegment {
+		PlaybackSegment (boost::shared_ptr<AudioRegion> const& r, Evoral::Range<samplepos_t> const& a, size_t o)
+			: region (r), range (a), max_to (a.to), order (o) {}
+
+		boost::shared_ptr<AudioRegion> region;
+		Evoral::Range<samplepos_t>     range;
+		samplepos_t                    max_to; ///< largest range.to of the subtree
+		size_t                         order;  ///< segments with larger order are read first
+	};
+
+	typedef std::vector<PlaybackSegment> PlaybackMap;
+
+	void               build_playback_map ();
+	static void        flatten (RegionList const&, PlaybackMap&);
+	static samplepos_t augment_playback_map (PlaybackMap&, size_t lo, size_t hi);
+	static void        find_playback_segments (PlaybackMap const&, size_t lo, size_t hi, samplepos_t start, samplepos_t end, std::vector<PlaybackSegment>&);
+
+	/* audible segments of all regions, sorted by position, and
+	 * used as implicit interval tree. It is dropped on every edit,
+	 * and re-built by the next read. The pointer is guarded by
+	 * _playback_map_lock, which is not held while building.
+	 */
+	boost::shared_ptr<PlaybackMap const> _playback_map;
+	uint64_t                             _playback_map_generation;
+	Glib::Threads::Mutex                 _playback_map_lock;
+
 	int set_state (const XMLNode&, int version);
 	void dump () const;
 	bool region_changed (const PBD::PropertyChange&, boost::shared_ptr<Region>);
@@ -124,6 +124,11 @@ class LIBARDOUR_API AudioRegion : public Region
 
 	virtual samplecnt_t read_raw_internal (Sample*, samplepos_t, samplecnt_t, int channel) const;
 
+	/** Ask all sources to asynchronously load data for the given range
+	 * (in session samples), see AudioSource::prefetch()
+	 */
+	void prefetch (samplepos_t position, samplecnt_t cnt) const;
+
 	XMLNode& state ();
 	XMLNode& get_basic_state ();
 	int set_state (const XMLNode&, int version);
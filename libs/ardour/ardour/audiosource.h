@@ -61,6 +61,11 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 	virtual samplecnt_t read (Sample *dst, samplepos_t start, samplecnt_t cnt, int channel=0) const;
 	virtual samplecnt_t write (Sample *src, samplecnt_t cnt);
 
+	/** Hint that the given range will be read soon. This does not block,
+	 * data is loaded asynchronously (if supported by the source and OS).
+	 */
+	virtual void prefetch (samplepos_t /*start*/, samplecnt_t /*cnt*/) const {}
+
 	virtual float sample_rate () const = 0;
 
 	virtual void mark_streaming_write_completed (const Lock& lock);
@@ -97,6 +102,11 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 	virtual int setup_peakfile () { return 0; }
 	int close_peakfile ();
 
+	/** (re)write the lower resolution peak files if needed, called by the
+	 *  peak-building threads after peak_levels_ready () queued the source.
+	 */
+	void build_peak_levels () const;
+
 	int prepare_for_peakfile_writes ();
 	void done_with_peakfile_writes (bool done = true);
 
@@ -130,6 +140,9 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 				     bool force, bool intermediate_peaks_ready_signal,
 				     samplecnt_t samples_per_peak);
 
+	/** remove the lower resolution peak files derived from the peakfile */
+	void remove_peak_levels () const;
+
   private:
 	bool _peaks_built;
 	/** This mutex is used to protect both the _peaks_built
@@ -152,6 +165,26 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 	mutable off_t _last_map_off;
 	mutable size_t  _last_raw_map_length;
 	mutable boost::scoped_array<PeakData> peak_cache;
+
+	enum PeakLevelState {
+		PeakLevelsUnknown,
+		PeakLevelsQueued,
+		PeakLevelsStale, /* invalidated while queued or being built */
+		PeakLevelsReady,
+		PeakLevelsUnavailable
+	};
+
+	/** protects the peak level state below; never held while reading or
+	 *  writing files and only ever taken after _lock.
+	 */
+	mutable Glib::Threads::Mutex _peak_levels_lock;
+	mutable PeakLevelState _peak_levels;
+	mutable std::string    _peak_levels_src;   // peakfile the queued levels are built from
+	mutable off_t          _peak_levels_bytes; // amount of peak data in that file
+
+	std::string peak_level_path (samplecnt_t fpp) const;
+	bool peak_levels_ready () const;
+	void reset_peak_levels () const;
 };
 
 }
@@ -24,12 +24,14 @@
 #define __ardour_butler_h__
 
 #include <pthread.h>
+#include <vector>
 
 #include <glibmm/threads.h>
 
 #include "pbd/crossthread.h"
 #include "pbd/ringbuffer.h"
 #include "pbd/pool.h"
+#include "pbd/semutils.h"
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
 #include "ardour/session_handle.h"
@@ -38,6 +40,8 @@
 
 namespace ARDOUR {
 
+class Track;
+
 /**
  *  One of the Butler's functions is to clean up (ie delete) unused CrossThreadPools.
  *  When a thread with a CrossThreadPool terminates, its CTP is added to pool_trash.
@@ -96,6 +100,25 @@ private:
 
 	bool flush_tracks_to_disk_normal (boost::shared_ptr<RouteList>, uint32_t& errors);
 
+	/* disk I/O worker threads */
+	void start_workers ();
+	void stop_workers ();
+	static void* _worker_thread (void*);
+	void worker_thread ();
+
+	bool refill_tracks (boost::shared_ptr<RouteList>, uint32_t& errors);
+	void refill_some_tracks (Sample* sum_buffer, Sample* mixdown_buffer, gain_t* gain_buffer);
+
+	std::vector<pthread_t> _workers;
+	gint                   _workers_active; // atomic
+	PBD::Semaphore         _worker_run_sem;
+	PBD::Semaphore         _worker_done_sem;
+
+	/* refill queue, ordered by playback buffer load (lowest first) */
+	std::vector<boost::shared_ptr<Track> > _refill_list;
+	gint _refill_index;       // atomic, next entry of _refill_list to process
+	gint _refill_outstanding; // atomic
+
 	/**
 	 * Add request to butler thread request queue
 	 */
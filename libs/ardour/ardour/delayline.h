@@ -42,6 +42,8 @@ public:
 	bool set_name (const std::string& str);
 	bool set_delay (samplecnt_t signal_delay);
 	samplecnt_t delay () { return _pending_delay; }
+	/** @return true if run() will not modify the buffers */
+	bool passthrough () const { return _delay == 0 && _pending_delay == 0; }
 
 	/* processor interface */
 	bool display_to_user () const { return false; }
@@ -79,6 +79,15 @@ public:
 	 */
 	int do_refill ();
 
+	/** Same as do_refill() but using the given working buffers, which must
+	 * be of the same size as the ones allocated by allocate_working_buffers().
+	 * This allows tracks to be refilled concurrently (butler worker threads).
+	 */
+	int do_refill (Sample* sum_buffer, Sample* mixdown_buffer, gain_t* gain_buffer);
+
+	/** Number of samples of the working buffers used by do_refill() */
+	static samplecnt_t working_buffer_size () { return 2 * 1048576; }
+
 	/** For contexts outside the normal butler refill loop (allocates temporary working buffers) */
 	int do_refill_with_alloc (bool partial_fill, bool reverse);
 
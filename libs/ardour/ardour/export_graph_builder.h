@@ -25,7 +25,7 @@
 #include "ardour/export_handler.h"
 #include "ardour/export_analysis.h"
 
-#include "audiographer/utils/identity_vertex.h"
+#include "audiographer/sink.h"
 
 #include <boost/ptr_container/ptr_list.hpp>
 #include <glibmm/threadpool.h>
@@ -60,9 +60,8 @@ class LIBARDOUR_API ExportGraphBuilder
 	typedef ExportHandler::FileSpec FileSpec;
 
 	typedef boost::shared_ptr<AudioGrapher::Sink<Sample> > FloatSinkPtr;
-	typedef boost::shared_ptr<AudioGrapher::IdentityVertex<Sample> > IdentityVertexPtr;
 	typedef boost::shared_ptr<AudioGrapher::Analyser> AnalysisPtr;
-	typedef std::map<ExportChannelPtr,  IdentityVertexPtr> ChannelMap;
+	typedef std::map<ExportChannelPtr, Sample const*> ChannelMap;
 	typedef std::map<std::string, AnalysisPtr> AnalysisMap;
 
   public:
@@ -90,6 +89,10 @@ class LIBARDOUR_API ExportGraphBuilder
 
 	void add_split_config (FileSpec const & config);
 
+	class ChannelConfig;
+	void process_parallel (samplecnt_t samples, bool last_cycle);
+	void process_channel_config (ChannelConfig*, samplecnt_t samples, bool last_cycle);
+
 	class Encoder {
             public:
 		template <typename T> boost::shared_ptr<AudioGrapher::Sink<T> > init (FileSpec const & new_config);
@@ -246,6 +249,7 @@ class LIBARDOUR_API ExportGraphBuilder
 	class ChannelConfig {
 	    public:
 		ChannelConfig (ExportGraphBuilder & parent, FileSpec const & new_config, ChannelMap & channel_map);
+		void process (samplecnt_t samples, bool last_cycle);
 		void add_child (FileSpec const & new_config);
 		void remove_children (bool remove_out_files);
 		bool operator== (FileSpec const & other_config) const;
@@ -269,7 +273,7 @@ class LIBARDOUR_API ExportGraphBuilder
 	typedef boost::ptr_list<ChannelConfig> ChannelConfigList;
 	ChannelConfigList channel_configs;
 
-	// The sources of all data, each channel is read only once
+	// The sources of all data, each channel is read only once per cycle
 	ChannelMap channels;
 
 	samplecnt_t process_buffer_samples;
@@ -283,6 +287,14 @@ class LIBARDOUR_API ExportGraphBuilder
 
 	Glib::ThreadPool     thread_pool;
 	Glib::Threads::Mutex engine_request_lock;
+
+	/* concurrent processing of channel configs (freewheel export) */
+	Glib::Threads::Mutex process_lock;
+	Glib::Threads::Cond  process_cond;
+	gint                 process_pending;
+	std::string          process_error;
+
+	Glib::Threads::Mutex intermediates_lock;
 };
 
 } // namespace ARDOUR
@@ -41,6 +41,7 @@
 namespace ARDOUR
 {
 class GraphNode;
+class GraphTaskList;
 class Graph;
 
 class Route;
@@ -76,6 +77,17 @@ public:
 
 	bool in_process_thread () const;
 
+	/** Process @a n items of the given list using idle DSP threads, and
+	 * wait for all of them to complete. The calling thread participates,
+	 * and may also process items forked by other nodes while waiting.
+	 *
+	 * This is realtime-safe and can be called from a GraphNode that is
+	 * currently being processed, or from the main process thread.
+	 * Items may use per-thread scratch buffers, the caller must hence
+	 * not hold any (other than route buffers) across this call.
+	 */
+	void process_tasks (GraphTaskList&, uint32_t n);
+
 protected:
 	virtual void session_going_away ();
 
@@ -83,6 +95,8 @@ private:
 	void reset_thread_list ();
 	void drop_threads ();
 	void run_one ();
+	bool run_task ();
+	void task_done (GraphTaskList&);
 	void main_thread ();
 	void prep ();
 	void dump (int chain) const;
@@ -93,6 +107,16 @@ private:
 	PBD::MPMCQueue<GraphNode*> _trigger_queue;      ///< nodes that can be processed
 	volatile guint             _trigger_queue_size; ///< number of entries in trigger-queue
 
+	struct GraphTask {
+		GraphTask () : tl (0), id (0) {}
+		GraphTask (GraphTaskList* l, uint32_t i) : tl (l), id (i) {}
+
+		GraphTaskList* tl;
+		uint32_t       id;
+	};
+
+	PBD::MPMCQueue<GraphTask> _task_queue; ///< items forked by nodes that are being processed
+
 	/** Start worker threads */
 	PBD::Semaphore _execution_sem;
 
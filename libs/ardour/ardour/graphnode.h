@@ -27,6 +27,8 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include "pbd/semutils.h"
+
 namespace ARDOUR
 {
 class Graph;
@@ -42,10 +44,32 @@ protected:
 	friend class Graph;
 	/** Nodes that we directly feed */
 	node_set_t _activation_set[2];
+	/** Nodes that we directly feed, ordered by decreasing critical path */
+	std::vector<GraphNode*> _activation_order[2];
 	/** The number of nodes that we directly feed us (one count for each chain) */
 	gint _init_refcount[2];
 };
 
+/** A set of independent work items, that can be processed concurrently
+ * by the DSP threads of the process graph, see Graph::process_tasks()
+ */
+class LIBARDOUR_API GraphTaskList
+{
+public:
+	GraphTaskList () : _pending (0), _done ("graph_tasks_done", 0) {}
+	virtual ~GraphTaskList () {}
+
+	/** Process the given item, called from a DSP thread */
+	virtual void run_task (uint32_t) = 0;
+
+private:
+	friend class Graph;
+	/** The number of items that have not yet completed */
+	volatile gint _pending;
+	/** Signalled when the last pending item has completed */
+	PBD::Semaphore _done;
+};
+
 /** A node on our processing graph, ie a Route */
 class LIBARDOUR_API GraphNode : public GraphActivision
 {
@@ -55,13 +79,34 @@ public:
 
 	void prep (int chain);
 	void trigger ();
+	void run (int chain);
+
+	/** Average processing time of this node (in usec), measured over recent cycles */
+	float cost () const { return _cost; }
+
+	/** Cost of the most expensive path from this node (inclusive)
+	 * to the output end of the graph, see update_critical_path()
+	 */
+	float critical_path () const { return _critical_path; }
 
-	void
-	run (int chain)
-	{
-		process ();
-		finish (chain);
-	}
+	/** Order the nodes that are fed by this node by decreasing
+	 * critical path, and update this node's critical path.
+	 * Must be called in reverse topological order.
+	 */
+	void update_critical_path (int chain);
+
+	/** Sort nodes by decreasing critical path */
+	struct CriticalPathSorter {
+		bool operator() (GraphNode const* a, GraphNode const* b) const {
+			return a->critical_path () > b->critical_path ();
+		}
+		bool operator() (node_ptr_t const& a, node_ptr_t const& b) const {
+			return a->critical_path () > b->critical_path ();
+		}
+	};
+
+protected:
+	boost::shared_ptr<Graph> const& graph () const { return _graph; }
 
 private:
 	void finish (int chain);
@@ -70,6 +115,9 @@ private:
 	boost::shared_ptr<Graph> _graph;
 
 	gint _refcount;
+
+	float _cost;
+	float _critical_path;
 };
 }
 
@@ -22,7 +22,9 @@
 #ifndef __ardour_internal_return_h__
 #define __ardour_internal_return_h__
 
-#include <list>
+#include <vector>
+
+#include "pbd/rcu.h"
 
 #include "ardour/buffer_set.h"
 #include "ardour/processor.h"
@@ -49,9 +51,11 @@ protected:
 	XMLNode& state ();
 
 private:
+	typedef std::vector<InternalSend*> SendList;
+
 	/** sends that we are receiving data from */
-	std::list<InternalSend*> _sends;
-	/** mutex to protect _sends */
+	SerializedRCUManager<SendList> _sends;
+	/** mutex to serialize add_send/remove_send */
 	Glib::Threads::Mutex _sends_mutex;
 };
 
@@ -21,6 +21,8 @@
 #ifndef __KMETERDSP_H
 #define __KMETERDSP_H
 
+#include <stdint.h>
+
 #include "ardour/libardour_visibility.h"
 
 class LIBARDOUR_API Kmeterdsp
@@ -36,8 +38,16 @@ public:
 
     static void init (int fsamp);
 
+    /** Process @a n_chn channels at once, using the multi-channel
+     * kernel selected by setup_hardware_optimization ().
+     */
+    static void process (Kmeterdsp* const* m, float const* const* p, uint32_t n_chn, int n);
+
 private:
 
+    void load_state (float& z1, float& z2) const;
+    void store_state (float z1, float z2);
+
     float          _z1;          // filter state
     float          _z2;          // filter state
     float          _rms;         // max rms value since last read()
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __ardour_mapped_audio_file_h__
+#define __ardour_mapped_audio_file_h__
+
+#include <string>
+#include <stdint.h>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+/** Read-only memory-map of the sample data of an uncompressed audio file.
+ *
+ * Only WAV, RF64 and CAF files with native-endian 16, 24 bit integer
+ * or 32 bit float samples are supported. Data is converted directly from
+ * the page-cache, without intermediate copies or syscalls.
+ *
+ * The file must not be modified while it is mapped.
+ */
+class LIBARDOUR_API MappedAudioFile
+{
+public:
+	/** @return a new map of the given file, or 0 if the file is not supported */
+	static MappedAudioFile* open (std::string const& path);
+
+	~MappedAudioFile ();
+
+	uint32_t    channels () const { return _channels; }
+	samplecnt_t length () const { return _length; }
+
+	/** De-interleave and convert samples of given channel, scaled by gain.
+	 * @return number of samples read (less than @param cnt at the end of the file)
+	 */
+	samplecnt_t read (Sample* dst, samplepos_t start, samplecnt_t cnt, uint32_t channel, gain_t gain) const;
+
+	/** Ask the OS to page in the given range of samples (all channels) */
+	void prefetch (samplepos_t start, samplecnt_t cnt) const;
+
+private:
+	enum Encoding {
+		Int16,
+		Int24,
+		Float32
+	};
+
+	MappedAudioFile (uint8_t* map, size_t size);
+
+	bool parse_riff (bool rf64);
+	bool parse_caf ();
+	bool set_format (uint32_t channels, uint32_t bits, bool is_float);
+	bool set_data (uint64_t offset, uint64_t size);
+
+	uint8_t*       _map;
+	size_t         _size;
+	uint8_t const* _data;
+	Encoding       _encoding;
+	uint32_t       _channels;
+	uint32_t       _bytes_per_sample;
+	uint32_t       _bytes_per_frame;
+	samplecnt_t    _length;
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_mapped_audio_file_h__ */
@@ -113,6 +113,8 @@ private:
 	std::vector<Iec2ppmdsp*> _iec2meter;
 	std::vector<Vumeterdsp*> _vumeter;
 
+	std::vector<Sample const*> _audio_data; // channel pointers, to meter all channels at once
+
 	MeterType _meter_type;
 };
 
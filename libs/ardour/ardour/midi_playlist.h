@@ -25,9 +25,14 @@
 
 #include <vector>
 #include <list>
+#include <map>
+#include <set>
 
 #include <boost/utility.hpp>
 
+#include <glibmm/threads.h>
+
+#include "evoral/EventList.h"
 #include "evoral/Parameter.h"
 
 #include "ardour/ardour.h"
@@ -86,6 +91,7 @@ public:
   protected:
 	void remove_dependents (boost::shared_ptr<Region> region);
 	void region_going_away (boost::weak_ptr<Region> region);
+	bool region_changed (const PBD::PropertyChange&, boost::shared_ptr<Region>);
 
   private:
 	void dump () const;
@@ -94,6 +100,25 @@ public:
 	samplepos_t  _read_end;
 
 	RTMidiBuffer _rendered;
+
+	/* Events of each region, sorted by time, kept between calls to
+	 * render() so that only modified regions need to be read again.
+	 */
+	typedef Evoral::EventList<samplepos_t>       RenderedEvents;
+	typedef std::map<PBD::ID, RenderedEvents>    RenderCache;
+
+	void init_render_cache ();
+	void drop_render_cache ();
+	void tempo_map_changed ();
+
+	RenderCache          _render_cache;
+	uint32_t             _render_filter; ///< channel mode and mask used for the cache
+	NoteMode             _render_note_mode;
+	Glib::Threads::Mutex _render_lock;
+
+	std::set<PBD::ID>    _render_dirty; ///< regions that need to be rendered again
+	bool                 _render_reset; ///< all regions need to be rendered again
+	Glib::Threads::Mutex _render_dirty_lock;
 };
 
 } /* namespace ARDOUR */
@@ -35,6 +35,10 @@ extern "C" {
 
 LIBARDOUR_API void x86_sse_find_peaks              (float const* buf, uint32_t nsamples, float* min, float* max);
 
+LIBARDOUR_API void x86_sse_kmeter_process          (float const* const* src, uint32_t n_chn, uint32_t nframes, float omega, float* z1, float* z2);
+LIBARDOUR_API void x86_sse_ppm_process             (float const* const* src, uint32_t n_chn, uint32_t nframes, float w1, float w2, float w3, float* z1, float* z2, float* m);
+LIBARDOUR_API void x86_sse_vumeter_process         (float const* const* src, uint32_t n_chn, uint32_t nframes, float w, float* z1, float* z2, float* m);
+
 extern "C" {
 /* AVX functions */
 	LIBARDOUR_API float x86_sse_avx_compute_peak          (float const* buf, uint32_t nsamples, float current);
@@ -44,6 +48,9 @@ extern "C" {
 	LIBARDOUR_API void  x86_sse_avx_copy_vector           (float* dst, float const* src, uint32_t nframes);
 #ifndef PLATFORM_WINDOWS
 	LIBARDOUR_API void  x86_sse_avx_find_peaks            (float const* buf, uint32_t nsamples, float* min, float* max);
+	LIBARDOUR_API void  x86_sse_avx_kmeter_process        (float const* const* src, uint32_t n_chn, uint32_t nframes, float omega, float* z1, float* z2);
+	LIBARDOUR_API void  x86_sse_avx_ppm_process           (float const* const* src, uint32_t n_chn, uint32_t nframes, float w1, float w2, float w3, float* z1, float* z2, float* m);
+	LIBARDOUR_API void  x86_sse_avx_vumeter_process       (float const* const* src, uint32_t n_chn, uint32_t nframes, float w, float* z1, float* z2, float* m);
 #endif
 }
 #ifdef PLATFORM_WINDOWS
@@ -96,4 +103,8 @@ LIBARDOUR_API void  default_mix_buffers_with_gain     (ARDOUR::Sample* dst, ARDO
 LIBARDOUR_API void  default_mix_buffers_no_gain       (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 LIBARDOUR_API void  default_copy_vector               (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 
+LIBARDOUR_API void  default_kmeter_process            (ARDOUR::Sample const* const* src, uint32_t n_chn, ARDOUR::pframes_t nframes, float omega, float* z1, float* z2);
+LIBARDOUR_API void  default_ppm_process               (ARDOUR::Sample const* const* src, uint32_t n_chn, ARDOUR::pframes_t nframes, float w1, float w2, float w3, float* z1, float* z2, float* m);
+LIBARDOUR_API void  default_vumeter_process           (ARDOUR::Sample const* const* src, uint32_t n_chn, ARDOUR::pframes_t nframes, float w, float* z1, float* z2, float* m);
+
 #endif /* __ardour_mix_h__ */
@@ -51,6 +51,7 @@
 #include "ardour/ardour.h"
 #include "ardour/data_type.h"
 #include "ardour/region.h"
+#include "ardour/region_index.h"
 #include "ardour/session_object.h"
 
 namespace ARDOUR {
@@ -179,6 +180,11 @@ public:
 
 	void update_after_tempo_map_change ();
 
+	/** Called by a region when its position or length was modified while
+	 * its property changes are suspended (and the playlist is not yet notified).
+	 */
+	void region_extent_changed ();
+
 	boost::shared_ptr<Playlist> cut (std::list<AudioRange>&, bool result_is_hidden = true);
 	boost::shared_ptr<Playlist> copy (std::list<AudioRange>&, bool result_is_hidden = true);
 	int                         paste (boost::shared_ptr<Playlist>, samplepos_t position, float times, const int32_t sub_num);
@@ -318,6 +324,7 @@ protected:
 		    , playlist (pl)
 		    , block_notify (do_block_notify)
 		{
+			++playlist->_region_writers;
 			if (block_notify) {
 				playlist->delay_notifications ();
 			}
@@ -325,6 +332,8 @@ protected:
 
 		~RegionWriteLock ()
 		{
+			playlist->invalidate_region_index ();
+			--playlist->_region_writers;
 			Glib::Threads::RWLock::WriterLock::release ();
 			if (block_notify) {
 				playlist->release_notifications ();
@@ -426,6 +435,11 @@ protected:
 	void ripple_locked (samplepos_t at, samplecnt_t distance, RegionList* exclude);
 	void ripple_unlocked (samplepos_t at, samplecnt_t distance, RegionList* exclude, ThawList& thawlist);
 
+	/** called whenever the set of regions, their extent, layering or
+	 * properties change.
+	 */
+	virtual void invalidate_playback_map () {}
+
 	virtual void remove_dependents (boost::shared_ptr<Region> /*region*/) {}
 	virtual void region_going_away (boost::weak_ptr<Region> /*region*/) {}
 
@@ -468,6 +482,25 @@ private:
 
 	mutable Glib::Threads::RWLock region_lock;
 
+	/* lookup index of the region-list, guarded by _region_index_lock.
+	 * It is not used while the current thread holds the write-lock,
+	 * since the list may be modified at any time.
+	 */
+	mutable RegionIndex          _region_index;
+	mutable Glib::Threads::Mutex _region_index_lock;
+	uint32_t                     _region_writers;
+
+	enum RegionIndexQuery {
+		IndexTouched,
+		IndexStartWithin,
+		IndexEndWithin
+	};
+
+	bool use_region_index () const;
+	bool query_region_index (RegionIndexQuery, samplepos_t start, samplepos_t end, RegionList&) const;
+	bool count_region_index (samplepos_t sample, uint32_t& cnt) const;
+	void invalidate_region_index ();
+
 private:
 	void setup_layering_indices (RegionList const&);
 	void coalesce_and_check_crossfades (std::list<Evoral::Range<samplepos_t> >);
@@ -162,6 +162,11 @@ public:
 
 	virtual int  set_block_size (pframes_t nframes) = 0;
 	virtual bool requires_fixed_sized_buffers () const { return false; }
+	/** @return true if parameter changes passed to set_parameter() are
+	 * applied at the given sample-offset of the following connect_and_run()
+	 * call. Automation does not need to split the process cycle.
+	 */
+	virtual bool sample_accurate_automation () const { return false; }
 	virtual bool inplace_broken () const { return false; }
 	virtual bool connect_all_audio_outputs () const { return false; }
 
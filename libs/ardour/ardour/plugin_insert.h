@@ -36,6 +36,7 @@
 #include "ardour/libardour_visibility.h"
 #include "ardour/chan_mapping.h"
 #include "ardour/fixed_delay.h"
+#include "ardour/graphnode.h"
 #include "ardour/io.h"
 #include "ardour/types.h"
 #include "ardour/parameter_descriptor.h"
@@ -356,6 +357,7 @@ private:
 
 	bool _configured;
 	bool _no_inplace;
+	bool _parallel_instances;
 	bool _strict_io;
 	bool _custom_cfg;
 	bool _maps_from_state;
@@ -404,8 +406,31 @@ private:
 	PinMappings _out_map;
 	ChanMapping _thru_map; // out-idx <=  in-idx
 
+	/* replicated plugin instances, see connect_and_run() */
+	class InstanceRunner : public GraphTaskList
+	{
+	public:
+		void run_task (uint32_t);
+
+		Plugins const*     plugins;
+		PinMappings const* in_map;
+		PinMappings const* out_map;
+		BufferSet*         bufs;
+		samplepos_t        start;
+		samplepos_t        end;
+		double             speed;
+		pframes_t          nframes;
+		samplecnt_t        offset;
+		uint64_t           first_usec; /* duration of the first instance */
+		volatile gint      failed;
+	};
+
+	InstanceRunner _instance_runner;
+	float          _instance_dsp_usec; /* average duration of a single instance */
+
 	void automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t end, double speed, pframes_t nframes);
-	void connect_and_run (BufferSet& bufs, samplepos_t start, samplecnt_t end, double speed, pframes_t nframes, samplecnt_t offset, bool with_auto);
+	void connect_and_run (BufferSet& bufs, samplepos_t start, samplecnt_t end, double speed, pframes_t nframes, samplecnt_t offset, bool with_auto, bool sub_block_auto = false);
+	bool can_automate_sub_block (samplepos_t end, double speed) const;
 	void bypass (BufferSet& bufs, pframes_t nframes);
 	void inplace_silence_unconnected (BufferSet&, const PinMappings&, samplecnt_t nframes, samplecnt_t offset) const;
 
@@ -420,6 +445,7 @@ private:
 
 	bool sanitize_maps ();
 	bool check_inplace ();
+	bool check_parallel () const;
 	void mapping_changed ();
 
 	boost::shared_ptr<Plugin> plugin_factory (boost::shared_ptr<Plugin>);
@@ -273,6 +273,7 @@ private:
 #ifdef VST3_SUPPORT
 	void vst3_plugin (std::string const& module_path, VST3Info const&);
 	bool run_vst3_scanner_app (std::string bundle_path) const;
+	void run_vst3_scanner_apps (std::vector<std::string> const& bundle_paths) const;
 #endif
 
 	int lxvst_discover_from_path (std::string path, bool cache_only = false);
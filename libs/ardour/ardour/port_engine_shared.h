@@ -40,6 +40,7 @@ class PortEngineSharedImpl;
 class PortManager;
 
 class BackendPort;
+class BackendMidiBuffer;
 
 typedef boost::shared_ptr<BackendPort> BackendPortPtr;
 typedef boost::shared_ptr<BackendPort> const & BackendPortHandle;
@@ -89,6 +90,16 @@ class LIBARDOUR_API BackendPort : public ProtoPort
 		return _connections;
 	}
 
+	typedef std::vector<BackendPort*> ConnectionList;
+
+	/** Flat copy of get_connections () for use in the process-callback.
+	 * It is compiled when connections change, and remains valid for as
+	 * long as the returned reference is held.
+	 */
+	boost::shared_ptr<ConnectionList> connection_list () const {
+		return _connection_list.reader ();
+	}
+
 	int  connect (BackendPortHandle port, BackendPortHandle self);
 	int  disconnect (BackendPortHandle port, BackendPortHandle self);
 	void disconnect_all (BackendPortHandle self);
@@ -107,6 +118,17 @@ class LIBARDOUR_API BackendPort : public ProtoPort
 protected:
 	PortEngineSharedImpl& _backend;
 
+	/** Sum the audio of all connected ports.
+	 *
+	 * @param buf buffer to mix into, if more than one port is connected
+	 * @return the given buffer, or the buffer of the connected port if
+	 * there is only one (which must not be modified).
+	 */
+	Sample* mix_connections (Sample* buf, pframes_t n_samples);
+
+	/** Merge the MIDI events of all connected ports into the given buffer */
+	void merge_connections (BackendMidiBuffer& buf, pframes_t n_samples);
+
 private:
 	std::string            _name;
 	std::string            _pretty_name;
@@ -116,11 +138,81 @@ private:
 	LatencyRange           _playback_latency_range;
 	std::set<BackendPortPtr> _connections;
 
+	SerializedRCUManager<ConnectionList> _connection_list;
+
+	/** MIDI events dropped by merge_connections (), reported
+	 * when connections change.
+	 */
+	gint _dropped_midi_events; /* atomic */
+
 	void store_connection (BackendPortHandle);
 	void remove_connection (BackendPortHandle);
+	void update_connection_list ();
 
 }; // class BackendPort
 
+/** MIDI event buffer of a backend port.
+ *
+ * Event data is packed into a pre-allocated arena, and indexed by a
+ * separate array of event headers which is kept sorted by time.
+ * Adding events, and merging the buffers of connected ports does not
+ * allocate memory.
+ */
+class LIBARDOUR_API BackendMidiBuffer
+{
+public:
+	BackendMidiBuffer (size_t max_events = 2048, size_t max_data = 32768);
+	BackendMidiBuffer (BackendMidiBuffer const&);
+
+	size_t size ()  const { return _events.size (); }
+	bool   empty () const { return _events.empty (); }
+
+	pframes_t      timestamp (size_t i)  const { return _events[i].timestamp; }
+	size_t         event_size (size_t i) const { return _events[i].size; }
+	uint8_t const* data (size_t i)       const { return &_data[_events[i].offset]; }
+
+	void clear ();
+
+	/** Add an event. Events that are not added in order are inserted
+	 * after all events with the same timestamp.
+	 * @return false if the buffer is full
+	 */
+	bool push_back (pframes_t timestamp, uint8_t const* data, size_t size);
+
+	/** Merge the events of the given buffer, events at the same time
+	 * are added after the events already present. If the buffer fills
+	 * up, the earliest events that fit are added.
+	 * @return the number of events that were dropped
+	 */
+	size_t merge (BackendMidiBuffer const&);
+
+	/** replace all events with those of the given buffer */
+	void copy (BackendMidiBuffer const& other) { clear (); merge (other); }
+
+private:
+	struct Event {
+		pframes_t timestamp;
+		uint32_t  size;
+		uint32_t  offset;
+	};
+
+	struct EventSorter {
+		bool operator() (Event const& a, Event const& b) const {
+			return a.timestamp < b.timestamp;
+		}
+	};
+
+	BackendMidiBuffer& operator= (BackendMidiBuffer const&);
+
+	Event adopt (BackendMidiBuffer const&, Event const&, bool bulk, uint32_t base);
+
+	std::vector<Event>   _events;
+	std::vector<Event>   _scratch; // used when merging
+	std::vector<uint8_t> _data;
+	size_t               _used;
+	size_t               _max_events;
+};
+
 class LIBARDOUR_API PortEngineSharedImpl
 {
 public:
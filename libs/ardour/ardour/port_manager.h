@@ -34,6 +34,7 @@
 #include "pbd/ringbuffer.h"
 
 #include "ardour/chan_count.h"
+#include "ardour/graphnode.h"
 #include "ardour/midiport_manager.h"
 #include "ardour/port.h"
 
@@ -41,6 +42,7 @@ namespace ARDOUR {
 
 class PortEngine;
 class AudioBackend;
+class AudioPort;
 class Session;
 
 class CircularSampleBuffer;
@@ -363,6 +365,29 @@ private:
 	SerializedRCUManager<AudioInputPorts> _audio_input_ports;
 	SerializedRCUManager<MIDIInputPorts>  _midi_input_ports;
 	volatile gint                         _reset_meters;
+
+	/* audio input resampling, see cycle_start().
+	 * The lists are only modified by the process thread, and replaced
+	 * by a larger instance when ports are added so that cycle_start()
+	 * does not allocate.
+	 */
+	class InputResampler : public GraphTaskList
+	{
+	public:
+		InputResampler () : nframes (0) {}
+		/* the lists are scratch space of the process thread, they are not copied */
+		InputResampler (InputResampler const&) : GraphTaskList (), nframes (0) {}
+
+		void run_task (uint32_t);
+
+		std::vector<std::pair<Sample const*, AudioPort*> >    inputs;
+		std::vector<std::pair<AudioPort*, AudioPort const*> > shared_inputs;
+		pframes_t                                             nframes;
+	};
+
+	SerializedRCUManager<InputResampler> _input_resampler;
+
+	void reserve_input_resampler (size_t n_ports);
 };
 
 } // namespace ARDOUR
@@ -210,6 +210,12 @@ CONFIG_VARIABLE_SPECIAL (std::string, default_session_parent_dir, "default-sessi
 #endif
 CONFIG_VARIABLE (bool, allow_special_bus_removal, "allow-special-bus-removal", false)
 CONFIG_VARIABLE (int32_t, processor_usage, "processor-usage", -1)
+CONFIG_VARIABLE (bool, intra_route_parallelism, "intra-route-parallelism", false)
+CONFIG_VARIABLE (int32_t, butler_threads, "butler-threads", -1) /* additional disk I/O threads, < 0: automatic */
+CONFIG_VARIABLE (bool, disk_read_ahead_hints, "disk-read-ahead-hints", false)
+CONFIG_VARIABLE (bool, mmap_audio_files, "mmap-audio-files", false)
+CONFIG_VARIABLE (int32_t, session_load_threads, "session-load-threads", -1) /* threads reading source files ahead while loading a session, < 0: automatic */
+CONFIG_VARIABLE (int32_t, peak_build_threads, "peak-build-threads", -1) /* < 0: automatic */
 CONFIG_VARIABLE (gain_t, max_gain, "max-gain", 2.0) /* +6.0dB */
 CONFIG_VARIABLE (uint32_t, max_recent_sessions, "max-recent-sessions", 10)
 CONFIG_VARIABLE (uint32_t, max_recent_templates, "max-recent-templates", 10)
@@ -234,6 +240,7 @@ CONFIG_VARIABLE (bool, discover_audio_units, "discover-audio-units", false)
 CONFIG_VARIABLE (bool, ask_replace_instrument, "ask-replace-instrument", true)
 CONFIG_VARIABLE (bool, ask_setup_instrument, "ask-setup-instrument", true)
 CONFIG_VARIABLE (uint32_t, limit_n_automatables, "limit-n-automatables", 512)
+CONFIG_VARIABLE (bool, sample_accurate_plugin_automation, "sample-accurate-plugin-automation", true) /* pass automation events to plugins that support it, instead of splitting the cycle */
 
 /* custom user plugin paths */
 CONFIG_VARIABLE (std::string, plugin_path_vst, "plugin-path-vst", "@default@")
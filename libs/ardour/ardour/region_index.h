@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __ardour_region_index_h__
+#define __ardour_region_index_h__
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class Region;
+
+/** Static interval-tree over the extents of a set of regions.
+ *
+ * Regions are kept in a vector sorted by position; the vector is
+ * interpreted as an implicit balanced binary tree (each sub-range's
+ * midpoint is its root) where every node caches the largest end of
+ * its subtree. Range queries are O(log n + k).
+ *
+ * The index is a snapshot: it must be re-built after regions are
+ * added, removed, moved or trimmed.
+ */
+class LIBARDOUR_API RegionIndex
+{
+public:
+	RegionIndex ();
+
+	void build (RegionList const&);
+	void clear ();
+
+	bool valid () const { return _valid; }
+
+	/** append regions overlapping [start, end] (inclusive), ordered by position */
+	void touched (samplepos_t start, samplepos_t end, RegionList&) const;
+	/** append regions covering the given sample, ordered by position */
+	void at (samplepos_t sample, RegionList& rl) const { touched (sample, sample, rl); }
+	/** @return the number of regions covering the given sample */
+	uint32_t count_at (samplepos_t sample) const;
+	/** append regions whose first sample is within [start, end], ordered by position */
+	void start_within (samplepos_t start, samplepos_t end, RegionList&) const;
+	/** append regions whose last sample is within [start, end], ordered by position */
+	void end_within (samplepos_t start, samplepos_t end, RegionList&) const;
+
+private:
+	struct Entry {
+		Entry (boost::shared_ptr<Region> const&);
+
+		samplepos_t               first;
+		samplepos_t               last;
+		samplepos_t               max_last; /* largest last sample of the subtree */
+		boost::shared_ptr<Region> region;
+	};
+
+	struct EntrySorter {
+		bool operator() (Entry const& a, Entry const& b) const {
+			return a.first < b.first;
+		}
+	};
+
+	samplepos_t augment (size_t lo, size_t hi);
+
+	template<typename Visitor>
+	void visit (size_t lo, size_t hi, samplepos_t start, samplepos_t end, Visitor&) const;
+
+	std::vector<Entry> _entries;
+	bool               _valid;
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_region_index_h__ */
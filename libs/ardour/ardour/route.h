@@ -747,6 +747,35 @@ private:
 	pframes_t latency_preroll (pframes_t nframes, samplepos_t& start_sample, samplepos_t& end_sample);
 
 	void run_route (samplepos_t start_sample, samplepos_t end_sample, pframes_t nframes, bool gain_automation_ok, bool run_disk_reader);
+
+	/** Consecutive sends that do not modify the route's buffers,
+	 * processed concurrently by the process graph.
+	 */
+	class SendBranches : public GraphTaskList
+	{
+	public:
+		struct Branch {
+			Send*       send;
+			samplepos_t start_sample;
+			samplepos_t end_sample;
+			bool        result_required;
+		};
+
+		void run_task (uint32_t);
+
+		/** The Send of each processor in _processors, or 0, cached
+		 * when the processor list is (re)configured.
+		 */
+		std::vector<Send*>  sends;
+		std::vector<Branch> branches;
+		BufferSet*          bufs;
+		double              speed;
+		pframes_t           nframes;
+	};
+
+	SendBranches _send_branches;
+
+	bool process_send_branches (ProcessorList::const_iterator&, size_t&, BufferSet&, samplepos_t, samplepos_t, double, pframes_t, samplecnt_t&);
 	void fill_buffers_with_input (BufferSet& bufs, boost::shared_ptr<IO> io, pframes_t nframes);
 
 	void reset_instrument_info ();
@@ -19,48 +19,44 @@
 #ifndef _ardour_rt_tasklist_h_
 #define _ardour_rt_tasklist_h_
 
-#include <list>
+#include <vector>
 #include <boost/function.hpp>
-
-#include "pbd/semutils.h"
+#include <boost/shared_ptr.hpp>
 
 #include "ardour/libardour_visibility.h"
+#include "ardour/graphnode.h"
 #include "ardour/types.h"
-#include "ardour/audio_backend.h"
-#include "ardour/session_handle.h"
 
 namespace ARDOUR {
 
-class LIBARDOUR_API RTTaskList
+class Graph;
+
+/** Run independent work items in parallel, using the DSP threads of the
+ * process graph (see Graph::process_tasks). Without a graph (a single DSP
+ * thread) items are processed in sequence.
+ *
+ * Must only be called from the process thread.
+ */
+class LIBARDOUR_API RTTaskList : public GraphTaskList
 {
 public:
-	RTTaskList ();
-	~RTTaskList ();
+	RTTaskList (boost::shared_ptr<Graph>);
 
-	// TODO use dedicated allocator of a boost::intrusive::list
-	typedef std::list<boost::function<void ()> > TaskList;
+	typedef std::vector<boost::function<void ()> > TaskList;
 
 	/** process tasks in list in parallel, wait for them to complete */
 	void process (TaskList const&);
 
-private:
-	gint _threads_active;
-	std::vector<pthread_t> _threads;
+	/** process @a n items of the given list in parallel, wait for them
+	 * to complete. Unlike the TaskList variant, this never allocates memory.
+	 */
+	void process (GraphTaskList&, uint32_t n);
 
-	void reset_thread_list ();
-	void drop_threads ();
+	void run_task (uint32_t);
 
-	void process_tasklist ();
-
-	static void* _thread_run (void *arg);
-	void run ();
-
-	Glib::Threads::Mutex _process_mutex;
-	Glib::Threads::Mutex _tasklist_mutex;
-	PBD::Semaphore _task_run_sem;
-	PBD::Semaphore _task_end_sem;
-
-	TaskList _tasklist;
+private:
+	boost::shared_ptr<Graph> _graph;
+	TaskList                 _tasklist;
 };
 
 } // namespace ARDOUR
@@ -31,6 +31,9 @@ namespace ARDOUR {
 	typedef void  (*mix_buffers_with_gain_t) (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, float);
 	typedef void  (*mix_buffers_no_gain_t)   (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 	typedef void  (*copy_vector_t)           (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
+	typedef void  (*kmeter_process_t)        (ARDOUR::Sample const* const*, uint32_t, pframes_t, float, float*, float*);
+	typedef void  (*ppm_process_t)           (ARDOUR::Sample const* const*, uint32_t, pframes_t, float, float, float, float*, float*, float*);
+	typedef void  (*vumeter_process_t)       (ARDOUR::Sample const* const*, uint32_t, pframes_t, float, float*, float*, float*);
 
 	LIBARDOUR_API extern compute_peak_t          compute_peak;
 	LIBARDOUR_API extern find_peaks_t            find_peaks;
@@ -38,6 +41,9 @@ namespace ARDOUR {
 	LIBARDOUR_API extern mix_buffers_with_gain_t mix_buffers_with_gain;
 	LIBARDOUR_API extern mix_buffers_no_gain_t   mix_buffers_no_gain;
 	LIBARDOUR_API extern copy_vector_t           copy_vector;
+	LIBARDOUR_API extern kmeter_process_t        kmeter_process;
+	LIBARDOUR_API extern ppm_process_t           ppm_process;
+	LIBARDOUR_API extern vumeter_process_t       vumeter_process;
 }
 
 #endif /* __ardour_runtime_functions_h__ */
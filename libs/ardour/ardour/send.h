@@ -92,6 +92,12 @@ public:
 
 	void run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sample, double speed, pframes_t nframes, bool);
 
+	/** @return true if run() currently leaves the route's buffers untouched
+	 * (no thru latency-compensation in effect), in which case independent
+	 * sends can be processed concurrently.
+	 */
+	bool is_branch () const;
+
 	bool can_support_io_configuration (const ChanCount& in, ChanCount& out);
 	bool configure_io (ChanCount in, ChanCount out);
 
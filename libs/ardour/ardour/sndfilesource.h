@@ -33,6 +33,8 @@
 
 namespace ARDOUR {
 
+class MappedAudioFile;
+
 class LIBARDOUR_API SndFileSource : public AudioFileSource {
   public:
 	/** Constructor to be called for existing external-to-session files */
@@ -70,6 +72,8 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 
 	bool clamped_at_unity () const;
 
+	void prefetch (samplepos_t start, samplecnt_t cnt) const;
+
 	static const Source::Flag default_writable_flags;
 
 	static int get_soundfile_info (const std::string& path, SoundFileInfo& _info, std::string& error_msg);
@@ -88,6 +92,8 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 	SNDFILE* _sndfile;
 	SF_INFO _info;
 	BroadcastInfo *_broadcast_info;
+	MappedAudioFile* _mapped;
+	bool _mapped_reads;
 
 	void init_sndfile ();
 	int open();
@@ -67,9 +67,16 @@ class LIBARDOUR_API SourceFactory {
         static Glib::Threads::Cond                       PeaksToBuild;
         static Glib::Threads::Mutex                      peak_building_lock;
 	static std::list< boost::weak_ptr<AudioSource> > files_with_peaks;
+	static std::list< boost::weak_ptr<AudioSource const> > files_with_peak_levels;
 
 	static int peak_work_queue_length ();
 	static int setup_peakfile (boost::shared_ptr<Source>, bool async);
+
+	/** Build peaks of the given source next, if they are queued to be built */
+	static void prioritize_peakfile (boost::shared_ptr<Source>);
+
+	/** Check or build the lower resolution peak files of the given source */
+	static void build_peak_levels (boost::shared_ptr<AudioSource const>);
 };
 
 }
@@ -602,6 +602,54 @@ private:
 	samplecnt_t                   _sample_rate;
 	mutable Glib::Threads::RWLock lock;
 
+	/** Flat, sorted copy of the positions of the sections in _metrics.
+	 * Lookups on _metrics use binary searches over these arrays
+	 * instead of walking the list.
+	 */
+	struct MetricIndex {
+		MetricIndex () : valid (false) {}
+
+		void clear ();
+
+		bool valid;
+
+		/* all sections, in list order */
+		std::vector<const MetricSection*> sections;
+		std::vector<samplepos_t>         samples;
+		std::vector<const TempoSection*> tempo_before; /* last tempo at or before this section */
+		std::vector<const MeterSection*> meter_before; /* last meter at or before this section */
+
+		/* active tempo sections */
+		std::vector<TempoSection*>       tempi;
+		std::vector<double>              tempo_minutes;
+		std::vector<double>              tempo_pulses;
+
+		/* meter sections */
+		std::vector<MeterSection*>       meters;
+		std::vector<double>              meter_minutes;
+		std::vector<double>              meter_beats;
+		std::vector<double>              meter_pulses;
+		std::vector<double>              meter_bars; /* BBT bar (zero based) as computed by beat_at_bbt_locked */
+	};
+
+	MetricIndex _index;
+
+	/** @return true if the index can be used for lookups in @param metrics */
+	bool use_index (const Metrics& metrics) const { return _index.valid && &metrics == &_metrics; }
+	void rebuild_index ();
+
+	/** Exclusive lock of the map. The index is invalidated while the lock is
+	 * held and re-built from _metrics before the lock is released.
+	 */
+	class MapWriterLock {
+	  public:
+		MapWriterLock (TempoMap& map) : _map (map), _lm (map.lock) { _map._index.valid = false; }
+		~MapWriterLock () { _map.rebuild_index (); }
+	  private:
+		TempoMap&                         _map;
+		Glib::Threads::RWLock::WriterLock _lm;
+	};
+
 	void recompute_tempi (Metrics& metrics);
 	void recompute_meters (Metrics& metrics);
 	void recompute_map (Metrics& metrics, samplepos_t end = -1);
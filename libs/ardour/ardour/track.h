@@ -137,6 +137,7 @@ public:
 	float playback_buffer_load () const;
 	float capture_buffer_load () const;
 	int do_refill ();
+	int do_refill (Sample* sum_buffer, Sample* mixdown_buffer, gain_t* gain_buffer);
 	int do_flush (RunContext, bool force = false);
 	void set_pending_overwrite (OverwriteReason);
 	int seek (samplepos_t, bool complete_refill = false);
@@ -363,6 +363,11 @@ public:
 
 	int set_block_size (pframes_t);
 
+	bool sample_accurate_automation () const
+	{
+		return true;
+	}
+
 	void set_owner (ARDOUR::SessionObject* o);
 
 	void add_slave (boost::shared_ptr<Plugin>, bool);
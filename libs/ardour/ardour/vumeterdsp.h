@@ -21,6 +21,8 @@
 #ifndef __VUMETERDSP_H
 #define __VUMETERDSP_H
 
+#include <stdint.h>
+
 #include "ardour/libardour_visibility.h"
 
 class LIBARDOUR_API Vumeterdsp
@@ -36,8 +38,16 @@ public:
 
     static void init (float fsamp);
 
+    /** Process @a n_chn channels at once, using the multi-channel
+     * kernel selected by setup_hardware_optimization ().
+     */
+    static void process (Vumeterdsp* const* vu, float const* const* p, uint32_t n_chn, int n);
+
 private:
 
+    void load_state (float& z1, float& z2, float& m);
+    void store_state (float z1, float z2, float m);
+
     float          _z1;          // filter state
     float          _z2;          // filter state
     float          _m;           // max value since last read()
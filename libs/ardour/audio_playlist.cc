@@ -24,6 +24,7 @@
 #include <algorithm>
 
 #include <cstdlib>
+#include <set>
 
 #include "ardour/types.h"
 #include "ardour/debug.h"
@@ -40,6 +41,7 @@ using namespace PBD;
 
 AudioPlaylist::AudioPlaylist (Session& session, const XMLNode& node, bool hidden)
 	: Playlist (session, node, DataType::AUDIO, hidden)
+	, _playback_map_generation (0)
 {
 #ifndef NDEBUG
 	XMLProperty const * prop = node.property("type");
@@ -59,16 +61,19 @@ AudioPlaylist::AudioPlaylist (Session& session, const XMLNode& node, bool hidden
 
 AudioPlaylist::AudioPlaylist (Session& session, string name, bool hidden)
 	: Playlist (session, name, DataType::AUDIO, hidden)
+	, _playback_map_generation (0)
 {
 }
 
 AudioPlaylist::AudioPlaylist (boost::shared_ptr<const AudioPlaylist> other, string name, bool hidden)
 	: Playlist (other, name, hidden)
+	, _playback_map_generation (0)
 {
 }
 
 AudioPlaylist::AudioPlaylist (boost::shared_ptr<const AudioPlaylist> other, samplepos_t start, samplecnt_t cnt, string name, bool hidden)
 	: Playlist (other, start, cnt, name, hidden)
+	, _playback_map_generation (0)
 {
 	RegionReadLock rlock2 (const_cast<AudioPlaylist*> (other.get()));
 	in_set_state++;
@@ -161,53 +166,49 @@ struct Segment {
 	Evoral::Range<samplepos_t> range;       ///< range of the region to read, in session samples
 };
 
-/** @param start Start position in session samples.
- *  @param cnt Number of samples to read.
- */
-ARDOUR::samplecnt_t
-AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, samplepos_t start, samplecnt_t cnt, unsigned chan_n)
+void
+AudioPlaylist::prefetch (samplepos_t start, samplecnt_t cnt)
 {
-	DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("Playlist %1 read @ %2 for %3, channel %4, regions %5 mixdown @ %6 gain @ %7\n",
-							   name(), start, cnt, chan_n, regions.size(), mixdown_buffer, gain_buffer));
-
-	/* optimizing this memset() away involves a lot of conditionals
-	   that may well cause more of a hit due to cache misses
-	   and related stuff than just doing this here.
-
-	   it would be great if someone could measure this
-	   at some point.
-
-	   one way or another, parts of the requested area
-	   that are not written to by Region::region_at()
-	   for all Regions that cover the area need to be
-	   zeroed.
-	*/
+	boost::shared_ptr<RegionList> all = regions_touched (start, start + cnt - 1);
 
-	memset (buf, 0, sizeof (Sample) * cnt);
-
-	/* this function is never called from a realtime thread, so
-	   its OK to block (for short intervals).
-	*/
+	for (RegionList::const_iterator i = all->begin (); i != all->end (); ++i) {
+		boost::shared_ptr<AudioRegion> ar = boost::dynamic_pointer_cast<AudioRegion> (*i);
+		if (ar && !ar->muted ()) {
+			ar->prefetch (start, cnt);
+		}
+	}
+}
 
-	Playlist::RegionReadLock rl (this);
+/** Sort segments by ascending position */
+struct SegmentPositionSorter {
+	template<typename T> bool operator() (T const& a, T const& b) const {
+		return a.range.from < b.range.from;
+	}
+};
 
-	/* Find all the regions that are involved in the bit we are reading,
-	   and sort them by descending layer and ascending position.
-	*/
-	boost::shared_ptr<RegionList> all = regions_touched_locked (start, start + cnt - 1);
-	all->sort (ReadSorter ());
+/** Sort segments by the order in which they were found */
+struct SegmentOrderSorter {
+	template<typename T> bool operator() (T const& a, T const& b) const {
+		return a.order < b.order;
+	}
+};
 
+/** Find the bits of regions that need to be read for the given range.
+ *  @param all Regions touching the range, sorted by descending layer and ascending position.
+ *  @param to_do Filled with the segments to read, top-most first.
+ *  @param solo_selection Playlist whose solo-selected regions are the only audible ones, or 0.
+ */
+static void
+find_segments (RegionList const& all, samplepos_t start, samplepos_t end, list<Segment>& to_do, Playlist* solo_selection)
+{
 	/* This will be a list of the bits of our read range that we have
 	   handled completely (ie for which no more regions need to be read).
 	   It is a list of ranges in session samples.
 	*/
 	Evoral::RangeList<samplepos_t> done;
 
-	/* This will be a list of the bits of regions that we need to read */
-	list<Segment> to_do;
-
 	/* Now go through the `all' list filling in `to_do' and `done' */
-	for (RegionList::iterator i = all->begin(); i != all->end(); ++i) {
+	for (RegionList::const_iterator i = all.begin(); i != all.end(); ++i) {
 		boost::shared_ptr<AudioRegion> ar = boost::dynamic_pointer_cast<AudioRegion> (*i);
 
 		/* muted regions don't figure into it at all */
@@ -216,7 +217,7 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, sa
 		}
 
 		/* check for the case of solo_selection */
-		const bool force_transparent = (_session.solo_selection_active() && SoloSelectedActive() && !SoloSelectedListIncludes( (const Region*) &(**i)));
+		const bool force_transparent = (solo_selection && !solo_selection->SoloSelectedListIncludes( (const Region*) &(**i)));
 		if (force_transparent) {
 			continue;
 		}
@@ -226,7 +227,7 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, sa
 		*/
 		Evoral::Range<samplepos_t> region_range = ar->range ();
 		region_range.from = max (region_range.from, start);
-		region_range.to = min (region_range.to, start + cnt - 1);
+		region_range.to = min (region_range.to, end);
 
 		/* ... and then remove the bits that are already done */
 
@@ -253,6 +254,285 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, sa
 			}
 		}
 	}
+}
+
+void
+AudioPlaylist::invalidate_playback_map ()
+{
+	Glib::Threads::Mutex::Lock lm (_playback_map_lock);
+	_playback_map.reset ();
+	++_playback_map_generation;
+}
+
+void
+AudioPlaylist::build_playback_map ()
+{
+	/* Caller must hold the region lock */
+
+	uint64_t generation;
+	{
+		Glib::Threads::Mutex::Lock lm (_playback_map_lock);
+		if (_playback_map) {
+			return;
+		}
+		generation = _playback_map_generation;
+	}
+
+	boost::shared_ptr<PlaybackMap> map (new PlaybackMap);
+	flatten (regions.rlist (), *map);
+
+	Glib::Threads::Mutex::Lock lm (_playback_map_lock);
+	if (generation == _playback_map_generation) {
+		/* not invalidated meanwhile */
+		_playback_map = map;
+	}
+}
+
+namespace {
+
+/** Start or end of a region, or of the body of an opaque region */
+struct SweepEvent {
+	enum Type {
+		RegionEnd,
+		BodyEnd,
+		BodyStart,
+		RegionStart
+	};
+
+	SweepEvent (samplepos_t p, size_t r, Type t) : pos (p), rank (r), type (t) {}
+
+	samplepos_t pos;
+	size_t      rank;
+	Type        type;
+
+	bool operator< (SweepEvent const& other) const {
+		return pos < other.pos;
+	}
+};
+
+} // anonymous namespace
+
+/** Compute the audible segments of all regions.
+ *
+ * A region is read at a given sample if it covers it, and no opaque
+ * region that is read before it (see ReadSorter) has its body there.
+ * This corresponds to find_segments () for the whole timeline, but is
+ * computed with a single sweep over the sorted region boundaries.
+ */
+void
+AudioPlaylist::flatten (RegionList const& rl, PlaybackMap& map)
+{
+	RegionList all;
+
+	for (RegionList::const_iterator i = rl.begin (); i != rl.end (); ++i) {
+		if ((*i)->length () > 0 && !(*i)->muted ()) {
+			all.push_back (*i);
+		}
+	}
+
+	all.sort (ReadSorter ());
+
+	/* regions by rank, top-most first */
+	vector<boost::shared_ptr<AudioRegion> > ranked;
+	vector<SweepEvent>                      events;
+
+	ranked.reserve (all.size ());
+	events.reserve (all.size () * 4);
+
+	for (RegionList::const_iterator i = all.begin (); i != all.end (); ++i) {
+		boost::shared_ptr<AudioRegion> ar = boost::dynamic_pointer_cast<AudioRegion> (*i);
+		size_t const rank = ranked.size ();
+		ranked.push_back (ar);
+
+		Evoral::Range<samplepos_t> const r = ar->range ();
+		events.push_back (SweepEvent (r.from, rank, SweepEvent::RegionStart));
+		events.push_back (SweepEvent (r.to + 1, rank, SweepEvent::RegionEnd));
+
+		if (ar->opaque ()) {
+			Evoral::Range<samplepos_t> const b = ar->body_range ();
+			if (b.from <= b.to) {
+				events.push_back (SweepEvent (b.from, rank, SweepEvent::BodyStart));
+				events.push_back (SweepEvent (b.to + 1, rank, SweepEvent::BodyEnd));
+			}
+		}
+	}
+
+	sort (events.begin (), events.end ());
+
+	size_t const none = ranked.size ();
+
+	set<size_t>         active;                             ///< regions covering the current position
+	set<size_t>         bodies;                             ///< opaque bodies covering the current position
+	vector<samplepos_t> seg_start (ranked.size (), -1);     ///< start of the current audible segment, or -1
+	vector<size_t>      added;                              ///< regions whose audibility may change
+
+	size_t top_body = none;
+
+	for (vector<SweepEvent>::const_iterator e = events.begin (); e != events.end ();) {
+		samplepos_t const pos = e->pos;
+
+		added.clear ();
+
+		for (; e != events.end () && e->pos == pos; ++e) {
+			switch (e->type) {
+				case SweepEvent::RegionEnd:
+					active.erase (e->rank);
+					if (seg_start[e->rank] >= 0) {
+						map.push_back (PlaybackSegment (ranked[e->rank], Evoral::Range<samplepos_t> (seg_start[e->rank], pos - 1), e->rank));
+						seg_start[e->rank] = -1;
+					}
+					break;
+				case SweepEvent::BodyEnd:
+					bodies.erase (e->rank);
+					break;
+				case SweepEvent::BodyStart:
+					bodies.insert (e->rank);
+					break;
+				case SweepEvent::RegionStart:
+					active.insert (e->rank);
+					added.push_back (e->rank);
+					break;
+			}
+		}
+
+		/* regions up to (and including) the top-most body are audible */
+		size_t const prev_top = top_body;
+		top_body = bodies.empty () ? none : *bodies.begin ();
+
+		set<size_t>::const_iterator a   = active.upper_bound (min (prev_top, top_body));
+		set<size_t>::const_iterator end = active.upper_bound (max (prev_top, top_body));
+
+		for (; a != end; ++a) {
+			added.push_back (*a);
+		}
+
+		for (vector<size_t>::const_iterator r = added.begin (); r != added.end (); ++r) {
+			bool const audible = *r <= top_body;
+			if (audible && seg_start[*r] < 0) {
+				seg_start[*r] = pos;
+			} else if (!audible && seg_start[*r] >= 0) {
+				map.push_back (PlaybackSegment (ranked[*r], Evoral::Range<samplepos_t> (seg_start[*r], pos - 1), *r));
+				seg_start[*r] = -1;
+			}
+		}
+	}
+
+	stable_sort (map.begin (), map.end (), SegmentPositionSorter ());
+	augment_playback_map (map, 0, map.size ());
+}
+
+samplepos_t
+AudioPlaylist::augment_playback_map (PlaybackMap& map, size_t lo, size_t hi)
+{
+	if (lo >= hi) {
+		return -1;
+	}
+
+	size_t const     mid = lo + (hi - lo) / 2;
+	PlaybackSegment& s   = map[mid];
+
+	s.max_to = max (s.range.to, max (augment_playback_map (map, lo, mid), augment_playback_map (map, mid + 1, hi)));
+	return s.max_to;
+}
+
+void
+AudioPlaylist::find_playback_segments (PlaybackMap const& map, size_t lo, size_t hi, samplepos_t start, samplepos_t end, vector<PlaybackSegment>& segments)
+{
+	if (lo >= hi) {
+		return;
+	}
+
+	size_t const           mid = lo + (hi - lo) / 2;
+	PlaybackSegment const& s   = map[mid];
+
+	if (s.max_to < start) {
+		return;
+	}
+
+	find_playback_segments (map, lo, mid, start, end, segments);
+
+	if (s.range.from > end) {
+		return;
+	}
+
+	if (s.range.to >= start) {
+		segments.push_back (s);
+	}
+
+	find_playback_segments (map, mid + 1, hi, start, end, segments);
+}
+
+/** @param start Start position in session samples.
+ *  @param cnt Number of samples to read.
+ */
+ARDOUR::samplecnt_t
+AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, samplepos_t start, samplecnt_t cnt, unsigned chan_n)
+{
+	DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("Playlist %1 read @ %2 for %3, channel %4, regions %5 mixdown @ %6 gain @ %7\n",
+							   name(), start, cnt, chan_n, regions.size(), mixdown_buffer, gain_buffer));
+
+	/* optimizing this memset() away involves a lot of conditionals
+	   that may well cause more of a hit due to cache misses
+	   and related stuff than just doing this here.
+
+	   it would be great if someone could measure this
+	   at some point.
+
+	   one way or another, parts of the requested area
+	   that are not written to by Region::region_at()
+	   for all Regions that cover the area need to be
+	   zeroed.
+	*/
+
+	memset (buf, 0, sizeof (Sample) * cnt);
+
+	/* this function is never called from a realtime thread, so
+	   its OK to block (for short intervals).
+	*/
+
+	Playlist::RegionReadLock rl (this);
+
+	/* This will be a list of the bits of regions that we need to read */
+	list<Segment> to_do;
+
+	boost::shared_ptr<PlaybackMap const> map;
+	Playlist* solo_selection = 0;
+
+	if (_session.solo_selection_active () && SoloSelectedActive ()) {
+		/* Audibility depends on the current selection */
+		solo_selection = this;
+	} else {
+		/* Edits only drop the map, so that a series of them (e.g. during
+		 * a drag) does not flatten the playlist each time. Re-build it once
+		 * here, that is a single O(n log n) sweep for all regions.
+		 */
+		build_playback_map ();
+
+		Glib::Threads::Mutex::Lock lm (_playback_map_lock);
+		map = _playback_map;
+	}
+
+	if (!map) {
+		/* Find all the regions that are involved in the bit we are reading,
+		   and sort them by descending layer and ascending position.
+		*/
+		boost::shared_ptr<RegionList> all = regions_touched_locked (start, start + cnt - 1);
+		all->sort (ReadSorter ());
+		find_segments (*all, start, start + cnt - 1, to_do, solo_selection);
+	} else {
+		/* Look up the audible segments of the (layered) playlist */
+		vector<PlaybackSegment> segments;
+		find_playback_segments (*map, 0, map->size (), start, start + cnt - 1, segments);
+
+		sort (segments.begin (), segments.end (), SegmentOrderSorter ());
+
+		for (vector<PlaybackSegment>::const_iterator i = segments.begin (); i != segments.end (); ++i) {
+			Evoral::Range<samplepos_t> d = i->range;
+			d.from = max (d.from, start);
+			d.to   = min (d.to, start + cnt - 1);
+			to_do.push_back (Segment (i->region, d));
+		}
+	}
 
 	/* Now go backwards through the to_do list doing the actual reads */
 	for (list<Segment>::reverse_iterator i = to_do.rbegin(); i != to_do.rend(); ++i) {
@@ -41,6 +41,7 @@ AudioPort::AudioPort (const std::string& name, PortFlags flags)
 	: Port (name, DataType::AUDIO, flags)
 	, _buffer (new AudioBuffer (0))
 	, _data (0)
+	, _src_idle (true)
 {
 	assert (name.find_first_of (':') == string::npos);
 	_src.setup (_resampler_quality);
@@ -74,18 +75,42 @@ AudioPort::cycle_start (pframes_t nframes)
 		_src.reset ();
 		memset (_data, 0, _cycle_nframes * sizeof (float));
 	} else {
-		_src.inp_data  = (float*)port_engine.get_buffer (_port_handle, nframes);
-		_src.inp_count = nframes;
-		_src.out_count = _cycle_nframes;
-		_src.set_rratio (_cycle_nframes / (double)nframes);
-		_src.out_data  = _data;
-		_src.process ();
-		while (_src.out_count > 0) {
-			*_src.out_data =  _src.out_data[-1];
-			++_src.out_data;
-			--_src.out_count;
-		}
+		resample_input (engine_get_input_buffer (nframes), nframes);
+	}
+}
+
+Sample const*
+AudioPort::engine_get_input_buffer (pframes_t nframes)
+{
+	return (Sample const*) port_engine.get_buffer (_port_handle, nframes);
+}
+
+void
+AudioPort::resample_input (Sample const* src, pframes_t nframes)
+{
+	_src_idle      = false;
+	_src.inp_data  = const_cast<float*> (src);
+	_src.inp_count = nframes;
+	_src.out_count = _cycle_nframes;
+	_src.set_rratio (_cycle_nframes / (double)nframes);
+	_src.out_data  = _data;
+	_src.process ();
+	while (_src.out_count > 0) {
+		*_src.out_data =  _src.out_data[-1];
+		++_src.out_data;
+		--_src.out_count;
+	}
+}
+
+void
+AudioPort::share_resampled_input (AudioPort const& other)
+{
+	/* other port is fed by the same source, and has already been resampled */
+	if (!_src_idle) {
+		_src.reset ();
+		_src_idle = true;
 	}
+	memcpy (_data, other._data, _cycle_nframes * sizeof (Sample));
 }
 
 void
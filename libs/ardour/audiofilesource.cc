@@ -165,6 +165,7 @@ AudioFileSource::~AudioFileSource ()
 	if (removable()) {
 		::g_unlink (_path.c_str());
 		::g_unlink (_peakpath.c_str());
+		remove_peak_levels ();
 	}
 }
 
@@ -253,6 +254,7 @@ AudioFileSource::mark_streaming_write_completed (const Lock& lock)
 int
 AudioFileSource::move_dependents_to_trash()
 {
+	remove_peak_levels ();
 	return ::g_unlink (_peakpath.c_str());
 }
 
@@ -1383,6 +1383,24 @@ AudioRegion::read_raw_internal (Sample* buf, samplepos_t pos, samplecnt_t cnt, i
 	return audio_source(channel)->read (buf, pos, cnt);
 }
 
+void
+AudioRegion::prefetch (samplepos_t position, samplecnt_t cnt) const
+{
+	samplepos_t const s = max (position, _position.val ());
+	samplepos_t const e = min (position + cnt, _position.val () + _length.val ());
+
+	if (s >= e) {
+		return;
+	}
+
+	for (SourceList::const_iterator i = _sources.begin (); i != _sources.end (); ++i) {
+		boost::shared_ptr<AudioSource> src = boost::dynamic_pointer_cast<AudioSource> (*i);
+		if (src) {
+			src->prefetch (_start.val () + (s - _position.val ()), e - s);
+		}
+	}
+}
+
 void
 AudioRegion::set_scale_amplitude (gain_t g)
 {
@@ -63,6 +63,7 @@
 #include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/session.h"
+#include "ardour/source_factory.h"
 
 #include "pbd/i18n.h"
 
@@ -79,6 +80,14 @@ bool AudioSource::_build_peakfiles = false;
 
 #define _FPP 256
 
+/* In addition to the peakfile (_FPP samples per peak), lower resolutions
+ * are kept in separate files. They are derived from the peakfile when first
+ * needed, so that zoomed-out views do not have to read and downsample all
+ * of its data.
+ */
+static const samplecnt_t peak_level_fpp[] = { 4096, 65536 };
+static const size_t      n_peak_levels    = sizeof (peak_level_fpp) / sizeof (peak_level_fpp[0]);
+
 AudioSource::AudioSource (Session& s, const string& name)
 	: Source (s, DataType::AUDIO, name)
 	, _length (0)
@@ -93,6 +102,8 @@ AudioSource::AudioSource (Session& s, const string& name)
 	, _last_scale (0.0)
 	, _last_map_off (0)
 	, _last_raw_map_length (0)
+	, _peak_levels (PeakLevelsUnknown)
+	, _peak_levels_bytes (0)
 {
 }
 
@@ -110,6 +121,8 @@ AudioSource::AudioSource (Session& s, const XMLNode& node)
 	, _last_scale (0.0)
 	, _last_map_off (0)
 	, _last_raw_map_length (0)
+	, _peak_levels (PeakLevelsUnknown)
+	, _peak_levels_bytes (0)
 {
 	if (set_state (node, Stateful::loading_state_version)) {
 		throw failed_constructor();
@@ -223,6 +236,9 @@ AudioSource::rename_peakfile (string newpath)
 
 	string oldpath = _peakpath;
 
+	/* these are re-built from the peakfile when needed */
+	remove_peak_levels ();
+
 	if (Glib::file_test (oldpath, Glib::FILE_TEST_EXISTS)) {
 		if (g_rename (oldpath.c_str(), newpath.c_str()) != 0) {
 			error << string_compose (_("cannot rename peakfile for %1 from %2 to %3 (%4)"), _name, oldpath, newpath, strerror (errno)) << endmsg;
@@ -242,6 +258,7 @@ AudioSource::initialize_peakfile (const string& audio_path, const bool in_sessio
 	GStatBuf statbuf;
 
 	_peakpath = construct_peak_filepath (audio_path, in_session);
+	reset_peak_levels ();
 
 	if (!empty() && !Glib::file_test (_peakpath.c_str(), Glib::FILE_TEST_EXISTS)) {
 		string oldpeak = construct_peak_filepath (audio_path, in_session, true);
@@ -334,7 +351,240 @@ AudioSource::write (Sample *dst, samplecnt_t cnt)
 int
 AudioSource::read_peaks (PeakData *peaks, samplecnt_t npeaks, samplepos_t start, samplecnt_t cnt, double samples_per_visual_peak) const
 {
-	return read_peaks_with_fpp (peaks, npeaks, start, cnt, samples_per_visual_peak, _FPP);
+	samplecnt_t fpp = _FPP;
+
+	if (samples_per_visual_peak >= peak_level_fpp[0] && peak_levels_ready ()) {
+		/* use the lowest resolution that does not need to be upsampled */
+		for (size_t n = 0; n < n_peak_levels && samples_per_visual_peak >= peak_level_fpp[n]; ++n) {
+			fpp = peak_level_fpp[n];
+		}
+	}
+
+	return read_peaks_with_fpp (peaks, npeaks, start, cnt, samples_per_visual_peak, fpp);
+}
+
+static std::string
+level_path (std::string const& peakpath, samplecnt_t fpp)
+{
+	return string_compose ("%1.%2", peakpath, fpp);
+}
+
+static void
+unlink_peak_levels (std::string const& peakpath)
+{
+	for (size_t n = 0; n < n_peak_levels; ++n) {
+		::g_unlink (level_path (peakpath, peak_level_fpp[n]).c_str ());
+	}
+}
+
+std::string
+AudioSource::peak_level_path (samplecnt_t fpp) const
+{
+	return level_path (_peakpath, fpp);
+}
+
+/** Forget the state of the peak levels, they are checked again when next used.
+ * A build that is queued or in progress discards its result.
+ */
+void
+AudioSource::reset_peak_levels () const
+{
+	Glib::Threads::Mutex::Lock lm (_peak_levels_lock);
+
+	if (_peak_levels == PeakLevelsQueued || _peak_levels == PeakLevelsStale) {
+		_peak_levels = PeakLevelsStale;
+	} else {
+		_peak_levels = PeakLevelsUnknown;
+	}
+}
+
+void
+AudioSource::remove_peak_levels () const
+{
+	reset_peak_levels ();
+
+	if (!_peakpath.empty ()) {
+		unlink_peak_levels (_peakpath);
+	}
+}
+
+/** @return true if the lower resolution peak files can be used.
+ *
+ * This does no file I/O. If the state of the peak levels is not yet known
+ * they are checked (and built if necessary) by the peak-building threads,
+ * until then the peakfile itself is used.
+ */
+bool
+AudioSource::peak_levels_ready () const
+{
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+
+		if (_peakfile_fd >= 0 || !_peaks_built || _peakpath.empty () || _peak_byte_max == 0) {
+			/* peakfile is (being) written, check again later */
+			return false;
+		}
+
+		Glib::Threads::Mutex::Lock lp (_peak_levels_lock);
+
+		if (_peak_levels != PeakLevelsUnknown) {
+			return _peak_levels == PeakLevelsReady;
+		}
+
+		_peak_levels       = PeakLevelsQueued;
+		_peak_levels_src   = _peakpath;
+		_peak_levels_bytes = _peak_byte_max;
+	}
+
+	SourceFactory::build_peak_levels (boost::dynamic_pointer_cast<AudioSource const> (shared_from_this ()));
+
+	return false;
+}
+
+/** @return true if the peak levels on disk match the given peakfile */
+static bool
+peak_levels_valid (std::string const& peakpath, off_t peak_bytes)
+{
+	GStatBuf statbuf;
+
+	if (g_stat (peakpath.c_str (), &statbuf) != 0) {
+		return false;
+	}
+
+	const off_t n_peaks = peak_bytes / sizeof (PeakData);
+
+	for (size_t n = 0; n < n_peak_levels; ++n) {
+		const off_t ratio = peak_level_fpp[n] / _FPP;
+		const off_t expected_size = ((n_peaks + ratio - 1) / ratio) * sizeof (PeakData);
+		GStatBuf    level_stat;
+
+		/* mtime may only have a resolution of one second: levels written
+		 * in the same second as the peakfile may pre-date it, rebuild them.
+		 */
+		if (g_stat (level_path (peakpath, peak_level_fpp[n]).c_str (), &level_stat) != 0
+		    || level_stat.st_size != expected_size
+		    || level_stat.st_mtime <= statbuf.st_mtime) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/** Write all peak levels, computed from the given peakfile. */
+static int
+write_peak_levels (std::string const& peakpath, off_t peak_bytes)
+{
+	const off_t chunksize = 65536; // peaks per read, a multiple of all level ratios
+
+	DEBUG_TRACE (DEBUG::Peaks, string_compose ("Building peak levels for %1\n", peakpath));
+
+	ScopedFileDescriptor sfd (g_open (peakpath.c_str (), O_RDONLY, 0444));
+
+	if (sfd < 0) {
+		return -1;
+	}
+
+	int  fds[n_peak_levels];
+	bool ok = true;
+
+	for (size_t n = 0; n < n_peak_levels; ++n) {
+		fds[n] = g_open (level_path (peakpath, peak_level_fpp[n]).c_str (), O_CREAT|O_TRUNC|O_WRONLY, 0664);
+		if (fds[n] < 0) {
+			ok = false;
+		}
+	}
+
+	boost::scoped_array<PeakData> buf (new PeakData[chunksize]);
+	boost::scoped_array<PeakData> level (new PeakData[chunksize]);
+
+	off_t remaining = peak_bytes / sizeof (PeakData);
+
+	while (ok && remaining > 0) {
+
+		const off_t   to_read = min (chunksize, remaining);
+		const ssize_t bytes   = to_read * sizeof (PeakData);
+
+		if (::read (sfd, buf.get (), bytes) != bytes) {
+			ok = false;
+			break;
+		}
+
+		for (size_t n = 0; n < n_peak_levels && ok; ++n) {
+			const off_t ratio = peak_level_fpp[n] / _FPP;
+			off_t       cnt   = 0;
+
+			for (off_t i = 0; i < to_read; i += ratio, ++cnt) {
+				const off_t end = min (i + ratio, to_read);
+				level[cnt] = buf[i];
+				for (off_t j = i + 1; j < end; ++j) {
+					level[cnt].min = min (level[cnt].min, buf[j].min);
+					level[cnt].max = max (level[cnt].max, buf[j].max);
+				}
+			}
+
+			const ssize_t level_bytes = cnt * sizeof (PeakData);
+			if (::write (fds[n], level.get (), level_bytes) != level_bytes) {
+				ok = false;
+			}
+		}
+
+		remaining -= to_read;
+	}
+
+	for (size_t n = 0; n < n_peak_levels; ++n) {
+		if (fds[n] >= 0) {
+			::close (fds[n]);
+		}
+	}
+
+	if (!ok) {
+		warning << string_compose (_("AudioSource: could not write peak levels for \"%1\" (%2)"), peakpath, strerror (errno)) << endmsg;
+		unlink_peak_levels (peakpath);
+		return -1;
+	}
+
+	return 0;
+}
+
+void
+AudioSource::build_peak_levels () const
+{
+	std::string peakpath;
+	off_t       peak_bytes;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_peak_levels_lock);
+
+		if (_peak_levels == PeakLevelsStale) {
+			/* invalidated before the build started, check again when used */
+			_peak_levels = PeakLevelsUnknown;
+			return;
+		}
+		if (_peak_levels != PeakLevelsQueued) {
+			return;
+		}
+
+		peakpath   = _peak_levels_src;
+		peak_bytes = _peak_levels_bytes;
+	}
+
+	/* neither _lock nor _peak_levels_lock is held during file I/O */
+	const bool valid = peak_levels_valid (peakpath, peak_bytes)
+	                   || write_peak_levels (peakpath, peak_bytes) == 0;
+
+	Glib::Threads::Mutex::Lock lm (_peak_levels_lock);
+
+	if (_peak_levels == PeakLevelsQueued) {
+		_peak_levels = valid ? PeakLevelsReady : PeakLevelsUnavailable;
+		return;
+	}
+
+	/* the peakfile was rewritten or moved meanwhile, the levels that were
+	 * just written describe old data.
+	 */
+	unlink_peak_levels (peakpath);
+	_peak_levels = PeakLevelsUnknown;
 }
 
 /** @param peaks Buffer to write peak data.
@@ -405,13 +655,16 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 
 	GStatBuf statbuf;
 
+	/* lower resolutions are stored in separate files, see read_peaks() */
+	const std::string peakpath = (samples_per_file_peak == _FPP) ? _peakpath : peak_level_path (samples_per_file_peak);
+
 	expected_peaks = (cnt / (double) samples_per_file_peak);
-	if (g_stat (_peakpath.c_str(), &statbuf) != 0) {
-		error << string_compose (_("Cannot open peakfile @ %1 for size check (%2)"), _peakpath, strerror (errno)) << endmsg;
+	if (g_stat (peakpath.c_str(), &statbuf) != 0) {
+		error << string_compose (_("Cannot open peakfile @ %1 for size check (%2)"), peakpath, strerror (errno)) << endmsg;
 		return -1;
 	}
 
-	if (!_captured_for.empty()) {
+	if (!_captured_for.empty() && samples_per_file_peak == _FPP) {
 
 		/* _captured_for is only set after a capture pass is
 		 * complete. so we know that capturing is finished for this
@@ -442,10 +695,10 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 		}
 	}
 
-	ScopedFileDescriptor sfd (g_open (_peakpath.c_str(), O_RDONLY, 0444));
+	ScopedFileDescriptor sfd (g_open (peakpath.c_str(), O_RDONLY, 0444));
 
 	if (sfd < 0) {
-		error << string_compose (_("Cannot open peakfile @ %1 for reading (%2)"), _peakpath, strerror (errno)) << endmsg;
+		error << string_compose (_("Cannot open peakfile @ %1 for reading (%2)"), peakpath, strerror (errno)) << endmsg;
 		return -1;
 	}
 
@@ -516,13 +769,13 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 
 			map_handle = CreateFileMapping(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
 			if (map_handle == NULL) {
-				error << string_compose (_("map failed - could not create file mapping for peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not create file mapping for peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
 			view_handle = MapViewOfFile(map_handle, FILE_MAP_READ, 0, read_map_off, map_length);
 			if (view_handle == NULL) {
-				error << string_compose (_("map failed - could not map peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not map peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
@@ -533,13 +786,13 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 			err_flag = UnmapViewOfFile (view_handle);
 			err_flag = CloseHandle(map_handle);
 			if(!err_flag) {
-				error << string_compose (_("unmap failed - could not unmap peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("unmap failed - could not unmap peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 #else
 			addr = (char*) mmap (0, map_length, PROT_READ, MAP_PRIVATE, sfd, read_map_off);
 			if (addr ==  MAP_FAILED) {
-				error << string_compose (_("map failed - could not mmap peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not mmap peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
@@ -611,13 +864,13 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 
 			map_handle = CreateFileMapping(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
 			if (map_handle == NULL) {
-				error << string_compose (_("map failed - could not create file mapping for peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not create file mapping for peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
 			view_handle = MapViewOfFile(map_handle, FILE_MAP_READ, 0, read_map_off, map_length);
 			if (view_handle == NULL) {
-				error << string_compose (_("map failed - could not map peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not map peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
@@ -628,13 +881,13 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 			err_flag = UnmapViewOfFile (view_handle);
 			err_flag = CloseHandle(map_handle);
 			if(!err_flag) {
-				error << string_compose (_("unmap failed - could not unmap peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("unmap failed - could not unmap peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 #else
 			addr = (char*) mmap (0, map_length, PROT_READ, MAP_PRIVATE, sfd, read_map_off);
 			if (addr ==  MAP_FAILED) {
-				error << string_compose (_("map failed - could not mmap peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not mmap peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
@@ -829,6 +1082,7 @@ AudioSource::build_peaks_from_scratch ()
 	if (ret) {
 		DEBUG_TRACE (DEBUG::Peaks, string_compose("Could not write peak data, attempting to remove peakfile %1\n", _peakpath));
 		::g_unlink (_peakpath.c_str());
+		remove_peak_levels ();
 	}
 
 	return ret;
@@ -845,6 +1099,7 @@ AudioSource::close_peakfile ()
 	if (!_peakpath.empty()) {
 		::g_unlink (_peakpath.c_str());
 	}
+	remove_peak_levels ();
 	_peaks_built = false;
 	return 0;
 }
@@ -860,6 +1115,8 @@ AudioSource::prepare_for_peakfile_writes ()
 		error << string_compose(_("AudioSource: cannot open _peakpath (c) \"%1\" (%2)"), _peakpath, strerror (errno)) << endmsg;
 		return -1;
 	}
+	/* the levels are derived from the data that is about to be replaced */
+	remove_peak_levels ();
 	return 0;
 }
 
@@ -881,6 +1138,9 @@ AudioSource::done_with_peakfile_writes (bool done)
 	close (_peakfile_fd);
 	_peakfile_fd = -1;
 
+	/* levels are re-built from the new data when needed */
+	reset_peak_levels ();
+
 	if (done) {
 		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
 		_peaks_built = true;
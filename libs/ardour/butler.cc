@@ -28,6 +28,11 @@
 #include <poll.h>
 #endif
 
+#include <algorithm>
+
+#include <boost/scoped_array.hpp>
+
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 #include "pbd/pthread_utils.h"
 
@@ -54,9 +59,14 @@ Butler::Butler(Session& s)
 	, _audio_playback_buffer_size(0)
 	, _midi_buffer_size(0)
 	, pool_trash(16)
+	, _worker_run_sem ("butler_worker_run", 0)
+	, _worker_done_sem ("butler_worker_done", 0)
 	, _xthread (true)
 {
 	g_atomic_int_set(&should_do_transport_work, 0);
+	g_atomic_int_set(&_workers_active, 0);
+	g_atomic_int_set(&_refill_index, 0);
+	g_atomic_int_set(&_refill_outstanding, 0);
 	SessionEvent::pool->set_trash (&pool_trash);
 
         /* catch future changes to parameters */
@@ -127,6 +137,8 @@ Butler::start_thread()
 	//pthread_detach (thread);
 	have_thread = true;
 
+	start_workers ();
+
 	// we are ready to request buffer adjustments
 	_session.adjust_capture_buffering ();
 	_session.adjust_playback_buffering ();
@@ -143,6 +155,212 @@ Butler::terminate_thread ()
 		queue_request (Request::Quit);
 		pthread_join (thread, &status);
 	}
+	stop_workers ();
+}
+
+void
+Butler::start_workers ()
+{
+	int32_t n_workers = Config->get_butler_threads ();
+
+	if (n_workers < 0) {
+		/* each worker allocates 24MB working buffers, be conservative */
+		n_workers = std::min<int32_t> (4, hardware_concurrency () / 2);
+	}
+
+	g_atomic_int_set (&_workers_active, 1);
+
+	for (int32_t i = 0; i < n_workers; ++i) {
+		pthread_t thread_id;
+		if (pthread_create_and_store ("disk butler worker", &thread_id, _worker_thread, this)) {
+			warning << _("Session: could not create butler worker thread") << endmsg;
+			break;
+		}
+		_workers.push_back (thread_id);
+	}
+}
+
+void
+Butler::stop_workers ()
+{
+	g_atomic_int_set (&_workers_active, 0);
+
+	for (std::vector<pthread_t>::const_iterator i = _workers.begin (); i != _workers.end (); ++i) {
+		_worker_run_sem.signal ();
+	}
+	for (std::vector<pthread_t>::const_iterator i = _workers.begin (); i != _workers.end (); ++i) {
+		pthread_join (*i, NULL);
+	}
+	_workers.clear ();
+	_worker_run_sem.reset ();
+	_worker_done_sem.reset ();
+}
+
+void*
+Butler::_worker_thread (void* arg)
+{
+	SessionEvent::create_per_thread_pool ("butler worker events", 64);
+	pthread_set_name (X_("butler worker"));
+	((Butler*) arg)->worker_thread ();
+	return 0;
+}
+
+void
+Butler::worker_thread ()
+{
+	boost::scoped_array<Sample> sum_buf (new Sample[DiskReader::working_buffer_size ()]);
+	boost::scoped_array<Sample> mix_buf (new Sample[DiskReader::working_buffer_size ()]);
+	boost::scoped_array<gain_t> gain_buf (new gain_t[DiskReader::working_buffer_size ()]);
+
+	while (true) {
+		_worker_run_sem.wait ();
+
+		if (!g_atomic_int_get (&_workers_active)) {
+			break;
+		}
+
+		refill_some_tracks (sum_buf.get (), mix_buf.get (), gain_buf.get ());
+
+		_worker_done_sem.signal ();
+	}
+}
+
+/** Process entries of the refill list until it is exhausted, or
+ * until the butler is interrupted. Called concurrently by all workers.
+ *
+ * The butler thread itself passes no working buffers, in which case
+ * the DiskReader's shared buffers are used.
+ */
+void
+Butler::refill_some_tracks (Sample* sum_buffer, Sample* mixdown_buffer, gain_t* gain_buffer)
+{
+	const gint n_tracks = _refill_list.size ();
+
+	while (!transport_work_requested() && should_run) {
+
+		gint n = g_atomic_int_add (&_refill_index, 1);
+
+		if (n >= n_tracks) {
+			break;
+		}
+
+		boost::shared_ptr<Track> tr = _refill_list[n];
+
+		// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), tr->playback_buffer_load()));
+		const int ret = sum_buffer ? tr->do_refill (sum_buffer, mixdown_buffer, gain_buffer) : tr->do_refill ();
+
+		switch (ret) {
+		case 0:
+			//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
+			break;
+
+		case 1:
+			DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name()));
+			g_atomic_int_set (&_refill_outstanding, 1);
+			break;
+
+		default:
+			error << string_compose(_("Butler read ahead failure on dstream %1"), tr->name()) << endmsg;
+			std::cerr << string_compose(_("Butler read ahead failure on dstream %1"), tr->name()) << std::endl;
+			break;
+		}
+	}
+}
+
+namespace {
+struct TrackLoad {
+	TrackLoad (boost::shared_ptr<Track> t) : track (t), load (t->playback_buffer_load ()) {}
+	bool operator< (TrackLoad const& other) const { return load < other.load; }
+
+	boost::shared_ptr<Track> track;
+	float load;
+};
+} // anonymous namespace
+
+/** Refill the playback buffers of all active tracks, those with the
+ * lowest buffer load first. If there are worker threads, tracks are
+ * refilled concurrently, and capture data is flushed to disk at the
+ * same time.
+ *
+ * @return true if there is outstanding disk work.
+ */
+bool
+Butler::refill_tracks (boost::shared_ptr<RouteList> rl, uint32_t& errors)
+{
+	std::vector<TrackLoad> tracks;
+
+	RouteList rl_with_auditioner = *rl;
+	rl_with_auditioner.push_back (_session.the_auditioner());
+
+	for (RouteList::iterator i = rl_with_auditioner.begin(); i != rl_with_auditioner.end(); ++i) {
+
+		boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+
+		if (!tr) {
+			continue;
+		}
+
+		boost::shared_ptr<IO> io = tr->input ();
+
+		if (io && !io->active()) {
+			/* don't read inactive tracks */
+			// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler skips inactive track %1\n", tr->name()));
+			continue;
+		}
+
+		tracks.push_back (TrackLoad (tr));
+	}
+
+	std::stable_sort (tracks.begin (), tracks.end ());
+
+	_refill_list.clear ();
+	for (std::vector<TrackLoad>::const_iterator i = tracks.begin (); i != tracks.end (); ++i) {
+		_refill_list.push_back (i->track);
+	}
+
+	g_atomic_int_set (&_refill_index, 0);
+	g_atomic_int_set (&_refill_outstanding, 0);
+
+	bool disk_work_outstanding = false;
+	const size_t n_workers = std::min (_workers.size (), _refill_list.size ());
+
+	DEBUG_TRACE (DEBUG::Butler, string_compose ("butler starts refill of %1 tracks using %2 workers, twr = %3\n", _refill_list.size (), n_workers, transport_work_requested()));
+
+	if (n_workers > 0) {
+		for (size_t i = 0; i < n_workers; ++i) {
+			_worker_run_sem.signal ();
+		}
+
+		/* write capture data while the workers refill playback buffers */
+		disk_work_outstanding = flush_tracks_to_disk_normal (rl, errors);
+
+		for (size_t i = 0; i < n_workers; ++i) {
+			_worker_done_sem.wait ();
+		}
+	} else {
+		refill_some_tracks (0, 0, 0);
+	}
+
+	if (g_atomic_int_get (&_refill_index) > 0 && g_atomic_int_get (&_refill_index) < (gint) _refill_list.size ()) {
+		/* we didn't get to all the streams */
+		disk_work_outstanding = true;
+	}
+
+	if (g_atomic_int_get (&_refill_outstanding)) {
+		disk_work_outstanding = true;
+	}
+
+	/* do not hold references to tracks while idle */
+	_refill_list.clear ();
+
+	if (n_workers == 0) {
+		if (!errors && transport_work_requested()) {
+			return disk_work_outstanding;
+		}
+		disk_work_outstanding = flush_tracks_to_disk_normal (rl, errors) || disk_work_outstanding;
+	}
+
+	return disk_work_outstanding;
 }
 
 void *
@@ -159,7 +377,6 @@ Butler::thread_work ()
 	uint32_t err = 0;
 
 	bool disk_work_outstanding = false;
-	RouteList::iterator i;
 
 	while (true) {
 		DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 butler main loop, disk work outstanding ? %2 @ %3\n", DEBUG_THREAD_SELF, disk_work_outstanding, g_get_monotonic_time()));
@@ -229,56 +446,7 @@ Butler::thread_work ()
 
 		boost::shared_ptr<RouteList> rl = _session.get_routes();
 
-		RouteList rl_with_auditioner = *rl;
-		rl_with_auditioner.push_back (_session.the_auditioner());
-
-		DEBUG_TRACE (DEBUG::Butler, string_compose ("butler starts refill loop, twr = %1\n", transport_work_requested()));
-
-		for (i = rl_with_auditioner.begin(); !transport_work_requested() && should_run && i != rl_with_auditioner.end(); ++i) {
-
-			boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
-
-			if (!tr) {
-				continue;
-			}
-
-			boost::shared_ptr<IO> io = tr->input ();
-
-			if (io && !io->active()) {
-				/* don't read inactive tracks */
-				// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler skips inactive track %1\n", tr->name()));
-				continue;
-			}
-			// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), tr->playback_buffer_load()));
-			switch (tr->do_refill ()) {
-			case 0:
-				//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
-				break;
-
-			case 1:
-				DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name()));
-				disk_work_outstanding = true;
-				break;
-
-			default:
-				error << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << endmsg;
-                                std::cerr << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << std::endl;
-				break;
-			}
-
-		}
-
-		if (i != rl_with_auditioner.begin() && i != rl_with_auditioner.end()) {
-			/* we didn't get to all the streams */
-			disk_work_outstanding = true;
-		}
-
-		if (!err && transport_work_requested()) {
-			DEBUG_TRACE (DEBUG::Butler, "transport work requested during refill, back to restart\n");
-			goto restart;
-		}
-
-		disk_work_outstanding = disk_work_outstanding || flush_tracks_to_disk_normal (rl, err);
+		disk_work_outstanding = refill_tracks (rl, err);
 
 		if (err && _session.actively_recording()) {
 			/* stop the transport and try to catch as much possible
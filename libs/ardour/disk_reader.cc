@@ -130,9 +130,9 @@ DiskReader::allocate_working_buffers ()
 	   need to reflect the maximum size we could use, which is 4MB reads, or 2M samples
 	   using 16 bit samples.
 	*/
-	_sum_buffer     = new Sample[2 * 1048576];
-	_mixdown_buffer = new Sample[2 * 1048576];
-	_gain_buffer    = new gain_t[2 * 1048576];
+	_sum_buffer     = new Sample[working_buffer_size ()];
+	_mixdown_buffer = new Sample[working_buffer_size ()];
+	_gain_buffer    = new gain_t[working_buffer_size ()];
 }
 
 void
@@ -1098,9 +1098,15 @@ DiskReader::audio_read (Sample*            sum_buffer,
 
 int
 DiskReader::do_refill ()
+{
+	return do_refill (_sum_buffer, _mixdown_buffer, _gain_buffer);
+}
+
+int
+DiskReader::do_refill (Sample* sum_buffer, Sample* mixdown_buffer, gain_t* gain_buffer)
 {
 	const bool reversed = !_session.transport_will_roll_forwards ();
-	return refill (_sum_buffer, _mixdown_buffer, _gain_buffer, 0, reversed);
+	return refill (sum_buffer, mixdown_buffer, gain_buffer, 0, reversed);
 }
 
 int
@@ -1273,6 +1279,15 @@ DiskReader::refill_audio (Sample* sum_buffer, Sample* mixdown_buffer, float* gai
 
 	samplepos_t file_sample_tmp = fsa;
 
+	if (_playlists[DataType::AUDIO] && Config->get_disk_read_ahead_hints ()) {
+		/* submit read-ahead for all channels at once, the
+		 * OS can then load them concurrently while we read
+		 * one channel after another.
+		 */
+		samplecnt_t const cnt = min (total_space, samples_to_read);
+		audio_playlist ()->prefetch (reversed ? max ((samplepos_t) 0, fsa - cnt) : fsa, cnt);
+	}
+
 #if 0
 	int64_t before = g_get_monotonic_time ();
 	int64_t elapsed;
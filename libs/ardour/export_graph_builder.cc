@@ -70,6 +70,7 @@ namespace ARDOUR {
 ExportGraphBuilder::ExportGraphBuilder (Session const & session)
 	: session (session)
 	, thread_pool (hardware_concurrency())
+	, process_pending (0)
 {
 	process_buffer_samples = session.engine().samples_per_cycle();
 }
@@ -99,14 +100,63 @@ ExportGraphBuilder::process (samplecnt_t samples, bool last_cycle)
 			assert (off < samples);
 		}
 
-		ConstProcessContext<Sample> context(&process_buffer[off], samples - off, 1);
-		if (last_cycle) { context().set_flag (ProcessContext<Sample>::EndOfInput); }
-		it->second->process (context);
+		it->second = &process_buffer[off];
+	}
+
+	/* Channel configurations (files) do not share any state, encode
+	 * them concurrently when freewheeling. Realtime export must not
+	 * block the process thread.
+	 */
+	if (_realtime || channel_configs.size () < 2) {
+		for (ChannelConfigList::iterator it = channel_configs.begin(); it != channel_configs.end(); ++it) {
+			it->process (samples - off, last_cycle);
+		}
+	} else {
+		process_parallel (samples - off, last_cycle);
 	}
 
 	return samples - off;
 }
 
+void
+ExportGraphBuilder::process_parallel (samplecnt_t samples, bool last_cycle)
+{
+	Glib::Threads::Mutex::Lock lm (process_lock);
+
+	process_error.clear ();
+	g_atomic_int_set (&process_pending, channel_configs.size ());
+
+	for (ChannelConfigList::iterator it = channel_configs.begin(); it != channel_configs.end(); ++it) {
+		thread_pool.push (sigc::bind (sigc::mem_fun (*this, &ExportGraphBuilder::process_channel_config), &*it, samples, last_cycle));
+	}
+
+	while (g_atomic_int_get (&process_pending) != 0) {
+		process_cond.wait (process_lock);
+	}
+
+	if (!process_error.empty ()) {
+		throw Exception (*this, process_error);
+	}
+}
+
+void
+ExportGraphBuilder::process_channel_config (ChannelConfig* cc, samplecnt_t samples, bool last_cycle)
+{
+	try {
+		cc->process (samples, last_cycle);
+	} catch (std::exception const & e) {
+		Glib::Threads::Mutex::Lock lm (process_lock);
+		if (process_error.empty ()) {
+			process_error = e.what ();
+		}
+	}
+
+	if (g_atomic_int_dec_and_test (&process_pending)) {
+		Glib::Threads::Mutex::Lock lm (process_lock);
+		process_cond.signal ();
+	}
+}
+
 bool
 ExportGraphBuilder::post_process ()
 {
@@ -695,6 +745,9 @@ ExportGraphBuilder::Intermediate::prepare_post_processing()
 		}
 	}
 	tmp_file->add_output (normalizer);
+
+	/* may be called concurrently from ExportGraphBuilder::process_parallel */
+	Glib::Threads::Mutex::Lock lm (parent.intermediates_lock);
 	parent.intermediates.push_back (this);
 }
 
@@ -891,22 +944,32 @@ ExportGraphBuilder::ChannelConfig::ChannelConfig (ExportGraphBuilder & parent, F
 	chunker.reset (new Chunker<Sample> (max_samples_out));
 	interleaver->add_output(chunker);
 
+	/* register the channels to read, the buffers are set each cycle */
 	ChannelList const & channel_list = config.channel_config->get_channels();
-	unsigned chan = 0;
-	for (ChannelList::const_iterator it = channel_list.begin(); it != channel_list.end(); ++it, ++chan) {
-		ChannelMap::iterator map_it = channel_map.find (*it);
-		if (map_it == channel_map.end()) {
-			std::pair<ChannelMap::iterator, bool> result_pair =
-				channel_map.insert (std::make_pair (*it, IdentityVertexPtr (new IdentityVertex<Sample> ())));
-			assert (result_pair.second);
-			map_it = result_pair.first;
-		}
-		map_it->second->add_output (interleaver->input (chan));
+	for (ChannelList::const_iterator it = channel_list.begin(); it != channel_list.end(); ++it) {
+		channel_map.insert (std::make_pair (*it, (Sample const*) 0));
 	}
 
 	add_child (new_config);
 }
 
+void
+ExportGraphBuilder::ChannelConfig::process (samplecnt_t samples, bool last_cycle)
+{
+	typedef ExportChannelConfiguration::ChannelList ChannelList;
+
+	ChannelList const & channel_list = config.channel_config->get_channels();
+	unsigned chan = 0;
+	for (ChannelList::const_iterator it = channel_list.begin(); it != channel_list.end(); ++it, ++chan) {
+		ChannelMap::const_iterator map_it = parent.channels.find (*it);
+		assert (map_it != parent.channels.end() && map_it->second);
+
+		ConstProcessContext<Sample> context (map_it->second, samples, 1);
+		if (last_cycle) { context().set_flag (ProcessContext<Sample>::EndOfInput); }
+		interleaver->input (chan)->process (context);
+	}
+}
+
 void
 ExportGraphBuilder::ChannelConfig::add_child (FileSpec const & new_config)
 {
@@ -154,6 +154,9 @@ apply_gain_to_buffer_t  ARDOUR::apply_gain_to_buffer  = 0;
 mix_buffers_with_gain_t ARDOUR::mix_buffers_with_gain = 0;
 mix_buffers_no_gain_t   ARDOUR::mix_buffers_no_gain   = 0;
 copy_vector_t           ARDOUR::copy_vector           = 0;
+kmeter_process_t        ARDOUR::kmeter_process        = 0;
+ppm_process_t           ARDOUR::ppm_process           = 0;
+vumeter_process_t       ARDOUR::vumeter_process       = 0;
 
 PBD::Signal1<void, std::string>                    ARDOUR::BootMessage;
 PBD::Signal3<void, std::string, std::string, bool> ARDOUR::PluginScanMessage;
@@ -199,6 +202,15 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_fma_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
+#ifdef PLATFORM_WINDOWS
+			kmeter_process        = x86_sse_kmeter_process;
+			ppm_process           = x86_sse_ppm_process;
+			vumeter_process       = x86_sse_vumeter_process;
+#else
+			kmeter_process        = x86_sse_avx_kmeter_process;
+			ppm_process           = x86_sse_avx_ppm_process;
+			vumeter_process       = x86_sse_avx_vumeter_process;
+#endif
 
 			generic_mix_functions = false;
 
@@ -214,6 +226,15 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_sse_avx_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
+#ifdef PLATFORM_WINDOWS
+			kmeter_process        = x86_sse_kmeter_process;
+			ppm_process           = x86_sse_ppm_process;
+			vumeter_process       = x86_sse_vumeter_process;
+#else
+			kmeter_process        = x86_sse_avx_kmeter_process;
+			ppm_process           = x86_sse_avx_ppm_process;
+			vumeter_process       = x86_sse_avx_vumeter_process;
+#endif
 
 			generic_mix_functions = false;
 
@@ -227,6 +248,9 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_sse_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
+			kmeter_process        = x86_sse_kmeter_process;
+			ppm_process           = x86_sse_ppm_process;
+			vumeter_process       = x86_sse_vumeter_process;
 
 			generic_mix_functions = false;
 		}
@@ -242,6 +266,9 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = arm_neon_mix_buffers_with_gain;
 			mix_buffers_no_gain   = arm_neon_mix_buffers_no_gain;
 			copy_vector           = arm_neon_copy_vector;
+			kmeter_process        = default_kmeter_process;
+			ppm_process           = default_ppm_process;
+			vumeter_process       = default_vumeter_process;
 
 			generic_mix_functions = false;
 		}
@@ -255,6 +282,9 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = veclib_mix_buffers_with_gain;
 			mix_buffers_no_gain   = veclib_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
+			kmeter_process        = default_kmeter_process;
+			ppm_process           = default_ppm_process;
+			vumeter_process       = default_vumeter_process;
 
 			generic_mix_functions = false;
 
@@ -274,6 +304,9 @@ setup_hardware_optimization (bool try_optimization)
 		mix_buffers_with_gain = default_mix_buffers_with_gain;
 		mix_buffers_no_gain   = default_mix_buffers_no_gain;
 		copy_vector           = default_copy_vector;
+		kmeter_process        = default_kmeter_process;
+		ppm_process           = default_ppm_process;
+		vumeter_process       = default_vumeter_process;
 
 		info << "No H/W specific optimizations in use" << endmsg;
 	}
@@ -77,6 +77,7 @@ Graph::Graph (Session& session)
 
 	/* pre-allocate memory */
 	_trigger_queue.reserve (1024);
+	_task_queue.reserve (1024);
 
 	ARDOUR::AudioEngine::instance ()->Running.connect_same_thread (engine_connections, boost::bind (&Graph::reset_thread_list, this));
 	ARDOUR::AudioEngine::instance ()->Stopped.connect_same_thread (engine_connections, boost::bind (&Graph::engine_stopped, this));
@@ -155,6 +156,7 @@ Graph::session_going_away ()
 	_init_trigger_list[1].clear ();
 	g_atomic_int_set (&_trigger_queue_size, 0);
 	_trigger_queue.clear ();
+	_task_queue.clear ();
 }
 
 void
@@ -210,6 +212,7 @@ Graph::clear_other_chain ()
 		if (_setup_chain != _pending_chain) {
 			for (node_list_t::iterator ni = _nodes_rt[_setup_chain].begin (); ni != _nodes_rt[_setup_chain].end (); ++ni) {
 				(*ni)->_activation_set[_setup_chain].clear ();
+				(*ni)->_activation_order[_setup_chain].clear ();
 			}
 
 			_nodes_rt[_setup_chain].clear ();
@@ -254,6 +257,18 @@ Graph::prep ()
 
 	g_atomic_int_set (&_terminal_refcnt, _n_terminal_nodes[chain]);
 
+	/* Prioritize nodes on the longest (most expensive) remaining path
+	 * to the output end, using the cost measured in previous cycles.
+	 * _nodes_rt is topologically sorted, so nodes are visited after
+	 * all the nodes they feed.
+	 */
+	for (node_list_t::reverse_iterator ri = _nodes_rt[chain].rbegin (); ri != _nodes_rt[chain].rend (); ++ri) {
+		(*ri)->update_critical_path (chain);
+	}
+
+	/* std::list::sort does not allocate */
+	_init_trigger_list[chain].sort (GraphNode::CriticalPathSorter ());
+
 	/* Trigger the initial nodes for processing, which are the ones at the `input' end */
 	for (i = _init_trigger_list[chain].begin (); i != _init_trigger_list[chain].end (); i++) {
 		g_atomic_int_inc (&_trigger_queue_size);
@@ -319,7 +334,7 @@ Graph::reached_terminal_node ()
 	}
 }
 
-/** Rechain our stuff using a list of routes (which can be in any order) and
+/** Rechain our stuff using a topologically sorted list of routes and
  *  a directed graph of their interconnections, which is guaranteed to be
  *  acyclic.
  */
@@ -347,6 +362,7 @@ Graph::rechain (boost::shared_ptr<RouteList> routelist, GraphEdges const& edges)
 	for (RouteList::iterator ri = routelist->begin (); ri != routelist->end (); ri++) {
 		(*ri)->_init_refcount[chain] = 0;
 		(*ri)->_activation_set[chain].clear ();
+		(*ri)->_activation_order[chain].clear ();
 		_nodes_rt[chain].push_back (*ri);
 	}
 
@@ -364,6 +380,7 @@ Graph::rechain (boost::shared_ptr<RouteList> routelist, GraphEdges const& edges)
 		/* Set up r's activation set */
 		for (set<GraphVertex>::iterator i = fed_from_r.begin (); i != fed_from_r.end (); ++i) {
 			r->_activation_set[chain].insert (*i);
+			r->_activation_order[chain].push_back (i->get ());
 		}
 
 		/* r has an input if there are some incoming edges to r in the graph */
@@ -401,6 +418,12 @@ Graph::run_one ()
 		return;
 	}
 
+	/* Items forked by a node that is currently being processed
+	 * have priority: the node waits for them to complete. */
+	if (run_task ()) {
+		return;
+	}
+
 	if (_trigger_queue.pop_front (to_run)) {
 		/* Wake up idle threads, but at most as many as there's
 		 * work in the trigger queue that can be processed by
@@ -434,6 +457,9 @@ Graph::run_one ()
 		g_atomic_int_dec_and_test (&_idle_thread_cnt);
 
 		/* Try to find some work to do */
+		if (run_task ()) {
+			return;
+		}
 		_trigger_queue.pop_front (to_run);
 	}
 
@@ -444,6 +470,84 @@ Graph::run_one ()
 	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 has finished run_one()\n", pthread_name ()));
 }
 
+bool
+Graph::run_task ()
+{
+	GraphTask t;
+
+	if (!_task_queue.pop_front (t)) {
+		return false;
+	}
+
+	t.tl->run_task (t.id);
+	task_done (*t.tl);
+	return true;
+}
+
+void
+Graph::task_done (GraphTaskList& tl)
+{
+	/* exactly one thread completes the last item, and wakes up the
+	 * thread that waits in process_tasks () */
+	if (g_atomic_int_dec_and_test (&tl._pending)) {
+		tl._done.signal ();
+	}
+}
+
+void
+Graph::process_tasks (GraphTaskList& tl, uint32_t n)
+{
+	if (n == 0) {
+		return;
+	}
+
+	if (n == 1 || g_atomic_uint_get (&_idle_thread_cnt) == 0 || g_atomic_int_get (&_terminate)) {
+		/* no other thread can help, process everything in this thread */
+		for (uint32_t i = 0; i < n; ++i) {
+			tl.run_task (i);
+		}
+		return;
+	}
+
+	g_atomic_int_set (&tl._pending, n);
+
+	/* queue all but the first item, which is processed by this thread */
+	guint queued = 0;
+	for (uint32_t i = 1; i < n; ++i) {
+		if (_task_queue.push_back (GraphTask (&tl, i))) {
+			++queued;
+		} else {
+			tl.run_task (i);
+			task_done (tl);
+		}
+	}
+
+	/* Threads may have gone to sleep or woken up meanwhile, only wake up
+	 * as many as are idle now that the items are queued.
+	 */
+	guint wakeup = std::min (g_atomic_uint_get (&_idle_thread_cnt), queued);
+	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 forks %2 tasks, signals %3 threads\n", pthread_name (), n, wakeup));
+	for (guint i = 0; i < wakeup; ++i) {
+		_execution_sem.signal ();
+	}
+
+	tl.run_task (0);
+	task_done (tl);
+
+	/* Help out while there are queued items, this may also process
+	 * items that were queued by other nodes. */
+	while (g_atomic_int_get (&tl._pending) > 0) {
+		if (!run_task ()) {
+			break;
+		}
+	}
+
+	/* Remaining items are in progress in other threads, wait for the
+	 * last one to complete. This also consumes the signal if all items
+	 * were completed above. */
+	tl._done.wait ();
+}
+
 void
 Graph::helper_thread ()
 {
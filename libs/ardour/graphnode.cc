@@ -18,6 +18,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+
 #include "ardour/graph.h"
 #include "ardour/graphnode.h"
 #include "ardour/route.h"
@@ -26,6 +28,8 @@ using namespace ARDOUR;
 
 GraphNode::GraphNode (boost::shared_ptr<Graph> graph)
 	: _graph (graph)
+	, _cost (0)
+	, _critical_path (0)
 {
 }
 
@@ -40,6 +44,30 @@ GraphNode::prep (int chain)
 	g_atomic_int_set (&_refcount, _init_refcount[chain]);
 }
 
+void
+GraphNode::run (int chain)
+{
+	const int64_t t0 = g_get_monotonic_time ();
+	process ();
+	const int64_t t1 = g_get_monotonic_time ();
+
+	/* low-pass filter, approx. 20 cycles */
+	_cost += .05f * ((float)(t1 - t0) - _cost);
+
+	finish (chain);
+}
+
+void
+GraphNode::update_critical_path (int chain)
+{
+	std::vector<GraphNode*>& order (_activation_order[chain]);
+
+	/* nodes fed by this node have already been updated */
+	std::sort (order.begin (), order.end (), GraphNode::CriticalPathSorter ());
+
+	_critical_path = _cost + (order.empty () ? 0 : order.front ()->critical_path ());
+}
+
 /** Called by an upstream node, when it has completed processing */
 void
 GraphNode::trigger ()
@@ -58,11 +86,11 @@ GraphNode::trigger ()
 void
 GraphNode::finish (int chain)
 {
-	node_set_t::iterator i;
-	bool                 feeds = false;
+	bool feeds = false;
 
-	/* Notify downstream nodes that depend on this node */
-	for (i = _activation_set[chain].begin (); i != _activation_set[chain].end (); ++i) {
+	/* Notify downstream nodes that depend on this node,
+	 * those with the longest remaining path first */
+	for (std::vector<GraphNode*>::const_iterator i = _activation_order[chain].begin (); i != _activation_order[chain].end (); ++i) {
 		(*i)->trigger ();
 		feeds = true;
 	}
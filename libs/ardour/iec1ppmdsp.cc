@@ -18,13 +18,18 @@
  */
 
 #include <math.h>
+
 #include "ardour/iec1ppmdsp.h"
+#include "ardour/mix.h"
+#include "ardour/runtime_functions.h"
 
 float Iec1ppmdsp::_w1;
 float Iec1ppmdsp::_w2;
 float Iec1ppmdsp::_w3;
 float Iec1ppmdsp::_g;
 
+static const uint32_t max_batch = 32; // channels per kernel call
+
 Iec1ppmdsp::Iec1ppmdsp (void)
 	: _z1 (0)
 	, _z2 (0)
@@ -35,40 +40,58 @@ Iec1ppmdsp::Iec1ppmdsp (void)
 Iec1ppmdsp::~Iec1ppmdsp (void) {}
 
 void
-Iec1ppmdsp::process (float const* p, int n)
+Iec1ppmdsp::load_state (float& z1, float& z2, float& m)
 {
-	float z1, z2, m, t;
-
 	z1 = _z1 > 20 ? 20 : (_z1 < 0 ? 0 : _z1);
 	z2 = _z2 > 20 ? 20 : (_z2 < 0 ? 0 : _z2);
 	m = _res ? 0: _m;
 	_res = false;
+}
 
-	n /= 4;
-	while (n--) {
-		z1 *= _w3;
-		z2 *= _w3;
-		t = fabsf (*p++);
-		if (t > z1) z1 += _w1 * (t - z1);
-		if (t > z2) z2 += _w2 * (t - z2);
-		t = fabsf (*p++);
-		if (t > z1) z1 += _w1 * (t - z1);
-		if (t > z2) z2 += _w2 * (t - z2);
-		t = fabsf (*p++);
-		if (t > z1) z1 += _w1 * (t - z1);
-		if (t > z2) z2 += _w2 * (t - z2);
-		t = fabsf (*p++);
-		if (t > z1) z1 += _w1 * (t - z1);
-		if (t > z2) z2 += _w2 * (t - z2);
-		t = z1 + z2;
-		if (t > m) m = t;
-	}
-
+void
+Iec1ppmdsp::store_state (float z1, float z2, float m)
+{
 	_z1 = z1 + 1e-10f;
 	_z2 = z2 + 1e-10f;
 	_m = m;
 }
 
+void
+Iec1ppmdsp::process (float const* p, int n)
+{
+	float z1, z2, m;
+
+	load_state (z1, z2, m);
+	default_ppm_process (&p, 1, n, _w1, _w2, _w3, &z1, &z2, &m);
+	store_state (z1, z2, m);
+}
+
+void
+Iec1ppmdsp::process (Iec1ppmdsp* const* ppm, float const* const* p, uint32_t n_chn, int n)
+{
+	float z1[max_batch];
+	float z2[max_batch];
+	float m[max_batch];
+
+	while (n_chn > 0) {
+		const uint32_t n_batch = n_chn < max_batch ? n_chn : max_batch;
+
+		for (uint32_t c = 0; c < n_batch; ++c) {
+			ppm[c]->load_state (z1[c], z2[c], m[c]);
+		}
+
+		ARDOUR::ppm_process (p, n_batch, n, _w1, _w2, _w3, z1, z2, m);
+
+		for (uint32_t c = 0; c < n_batch; ++c) {
+			ppm[c]->store_state (z1[c], z2[c], m[c]);
+		}
+
+		ppm   += n_batch;
+		p     += n_batch;
+		n_chn -= n_batch;
+	}
+}
+
 float
 Iec1ppmdsp::read (void)
 {
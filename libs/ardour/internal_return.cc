@@ -19,8 +19,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+
 #include <glibmm/threads.h>
 
+#include "ardour/audioengine.h"
 #include "ardour/internal_return.h"
 #include "ardour/internal_send.h"
 #include "ardour/route.h"
@@ -30,6 +33,7 @@ using namespace ARDOUR;
 
 InternalReturn::InternalReturn (Session& s, std::string const& name)
 	: Processor (s, name)
+	, _sends (new SendList)
 {
 	_display_to_user = false;
 }
@@ -42,13 +46,10 @@ InternalReturn::run (BufferSet& bufs, samplepos_t /*start_sample*/, samplepos_t
 	}
 	_active = _pending_active;
 
-	Glib::Threads::Mutex::Lock lm (_sends_mutex, Glib::Threads::TRY_LOCK);
+	/* the reference is held until all sends were mixed, see remove_send () */
+	boost::shared_ptr<SendList> sl = _sends.reader ();
 
-	if (!lm.locked ()) {
-		return;
-	}
-
-	for (list<InternalSend*>::iterator i = _sends.begin(); i != _sends.end(); ++i) {
+	for (SendList::const_iterator i = sl->begin(); i != sl->end(); ++i) {
 		if ((*i)->active () && (!(*i)->source_route() || (*i)->source_route()->active())) {
 			bufs.merge_from ((*i)->get_buffers(), nframes);
 		}
@@ -59,14 +60,35 @@ void
 InternalReturn::add_send (InternalSend* send)
 {
 	Glib::Threads::Mutex::Lock lm (_sends_mutex);
-	_sends.push_back (send);
+	RCUWriter<SendList> writer (_sends);
+	boost::shared_ptr<SendList> sl = writer.get_copy ();
+	sl->push_back (send);
 }
 
 void
 InternalReturn::remove_send (InternalSend* send)
 {
 	Glib::Threads::Mutex::Lock lm (_sends_mutex);
-	_sends.remove (send);
+
+	boost::shared_ptr<SendList> old = _sends.reader ();
+
+	{
+		RCUWriter<SendList> writer (_sends);
+		boost::shared_ptr<SendList> sl = writer.get_copy ();
+		sl->erase (std::remove (sl->begin (), sl->end (), send), sl->end ());
+	}
+	_sends.flush ();
+
+	if (!old.unique ()) {
+		/* the send is usually deleted after this returns, but a concurrent
+		 * ::run () still uses the previous list. It is called from the
+		 * process callback, which holds the process lock: wait for the cycle
+		 * to complete. A caller holding the process lock does not get here,
+		 * since no cycle can be in progress then, and other readers hold
+		 * _sends_mutex.
+		 */
+		Glib::Threads::Mutex::Lock pl (AudioEngine::instance()->process_lock ());
+	}
 }
 
 void
@@ -74,8 +96,9 @@ InternalReturn::set_playback_offset (samplecnt_t cnt)
 {
 	Processor::set_playback_offset (cnt);
 
-	Glib::Threads::Mutex::Lock lm (_sends_mutex); // TODO reader lock
-	for (list<InternalSend*>::iterator i = _sends.begin(); i != _sends.end(); ++i) {
+	Glib::Threads::Mutex::Lock lm (_sends_mutex);
+	boost::shared_ptr<SendList> sl = _sends.reader ();
+	for (SendList::const_iterator i = sl->begin(); i != sl->end(); ++i) {
 		(*i)->set_delay_out (cnt);
 	}
 }
@@ -18,10 +18,15 @@
  */
 
 #include <math.h>
+
 #include "ardour/kmeterdsp.h"
+#include "ardour/mix.h"
+#include "ardour/runtime_functions.h"
 
 float  Kmeterdsp::_omega;
 
+static const uint32_t max_batch = 32; // channels per kernel call
+
 Kmeterdsp::Kmeterdsp (void)
 	: _z1 (0)
 	, _z2 (0)
@@ -38,32 +43,16 @@ Kmeterdsp::init (int fsamp)
 }
 
 void
-Kmeterdsp::process (float const* p, int n)
+Kmeterdsp::load_state (float& z1, float& z2) const
 {
-	float  s, z1, z2;
-
-	// Get filter state.
 	z1 = _z1 > 50 ? 50 : (_z1 < 0 ? 0 : _z1);
 	z2 = _z2 > 50 ? 50 : (_z2 < 0 ? 0 : _z2);
+}
 
-	// Perform filtering. The second filter is evaluated
-	// only every 4th sample - this is just an optimisation.
-	n /= 4;  // Loop is unrolled by 4.
-	while (n--) {
-		s = *p++;
-		s *= s;
-		z1 += _omega * (s - z1);      // Update first filter.
-		s = *p++;
-		s *= s;
-		z1 += _omega * (s - z1);      // Update first filter.
-		s = *p++;
-		s *= s;
-		z1 += _omega * (s - z1);      // Update first filter.
-		s = *p++;
-		s *= s;
-		z1 += _omega * (s - z1);      // Update first filter.
-		z2 += 4 * _omega * (z1 - z2); // Update second filter.
-	}
+void
+Kmeterdsp::store_state (float z1, float z2)
+{
+	float s;
 
 	if (isnan(z1)) z1 = 0;
 	if (isnan(z2)) z2 = 0;
@@ -84,7 +73,46 @@ Kmeterdsp::process (float const* p, int n)
 	}
 }
 
-/* Returns highest _rms value since last call */
+void
+Kmeterdsp::process (float const* p, int n)
+{
+	float z1, z2;
+
+	// Get filter state.
+	load_state (z1, z2);
+
+	// Perform filtering. The second filter is evaluated
+	// only every 4th sample - this is just an optimisation.
+	default_kmeter_process (&p, 1, n, _omega, &z1, &z2);
+
+	store_state (z1, z2);
+}
+
+void
+Kmeterdsp::process (Kmeterdsp* const* m, float const* const* p, uint32_t n_chn, int n)
+{
+	float z1[max_batch];
+	float z2[max_batch];
+
+	while (n_chn > 0) {
+		const uint32_t n_batch = n_chn < max_batch ? n_chn : max_batch;
+
+		for (uint32_t c = 0; c < n_batch; ++c) {
+			m[c]->load_state (z1[c], z2[c]);
+		}
+
+		ARDOUR::kmeter_process (p, n_batch, n, _omega, z1, z2);
+
+		for (uint32_t c = 0; c < n_batch; ++c) {
+			m[c]->store_state (z1[c], z2[c]);
+		}
+
+		m     += n_batch;
+		p     += n_batch;
+		n_chn -= n_batch;
+	}
+}
+
 float
 Kmeterdsp::read ()
 {
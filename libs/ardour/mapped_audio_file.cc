@@ -0,0 +1,343 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifndef PLATFORM_WINDOWS
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "ardour/mapped_audio_file.h"
+
+using namespace ARDOUR;
+
+static inline uint16_t
+le16 (uint8_t const* p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+static inline uint32_t
+le32 (uint8_t const* p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint64_t
+le64 (uint8_t const* p)
+{
+	return le32 (p) | ((uint64_t)le32 (p + 4) << 32);
+}
+
+static inline uint32_t
+be32 (uint8_t const* p)
+{
+	return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+static inline uint64_t
+be64 (uint8_t const* p)
+{
+	return ((uint64_t)be32 (p) << 32) | be32 (p + 4);
+}
+
+static inline bool
+host_is_little_endian ()
+{
+	uint16_t const one = 1;
+	return *(uint8_t const*)&one == 1;
+}
+
+MappedAudioFile*
+MappedAudioFile::open (std::string const& path)
+{
+#ifdef PLATFORM_WINDOWS
+	return 0;
+#else
+	/* the whole file is mapped, do not exhaust the address-space */
+	if (sizeof (void*) < 8 || !host_is_little_endian ()) {
+		return 0;
+	}
+
+	int fd = ::open (path.c_str (), O_RDONLY);
+	if (fd < 0) {
+		return 0;
+	}
+
+	struct stat st;
+	if (fstat (fd, &st) != 0 || st.st_size < 44) {
+		::close (fd);
+		return 0;
+	}
+
+	void* map = mmap (0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+	/* the map remains valid after closing the descriptor */
+	::close (fd);
+
+	if (map == MAP_FAILED) {
+		return 0;
+	}
+
+	MappedAudioFile* maf = new MappedAudioFile ((uint8_t*)map, st.st_size);
+
+	bool ok;
+	if (!memcmp (map, "RIFF", 4)) {
+		ok = maf->parse_riff (false);
+	} else if (!memcmp (map, "RF64", 4)) {
+		ok = maf->parse_riff (true);
+	} else if (!memcmp (map, "caff", 4)) {
+		ok = maf->parse_caf ();
+	} else {
+		ok = false;
+	}
+
+	if (!ok) {
+		delete maf;
+		return 0;
+	}
+	return maf;
+#endif
+}
+
+MappedAudioFile::MappedAudioFile (uint8_t* map, size_t size)
+	: _map (map)
+	, _size (size)
+	, _data (0)
+	, _encoding (Float32)
+	, _channels (0)
+	, _bytes_per_sample (0)
+	, _bytes_per_frame (0)
+	, _length (0)
+{
+}
+
+MappedAudioFile::~MappedAudioFile ()
+{
+#ifndef PLATFORM_WINDOWS
+	munmap (_map, _size);
+#endif
+}
+
+bool
+MappedAudioFile::set_format (uint32_t channels, uint32_t bits, bool is_float)
+{
+	if (channels == 0) {
+		return false;
+	}
+	if (is_float && bits == 32) {
+		_encoding = Float32;
+	} else if (!is_float && bits == 24) {
+		_encoding = Int24;
+	} else if (!is_float && bits == 16) {
+		_encoding = Int16;
+	} else {
+		return false;
+	}
+	_channels         = channels;
+	_bytes_per_sample = bits / 8;
+	_bytes_per_frame  = channels * _bytes_per_sample;
+	return true;
+}
+
+bool
+MappedAudioFile::set_data (uint64_t offset, uint64_t size)
+{
+	if (_bytes_per_frame == 0 || offset >= _size) {
+		return false;
+	}
+	/* files that are still being written may report a larger size */
+	size    = std::min<uint64_t> (size, _size - offset);
+	_data   = _map + offset;
+	_length = size / _bytes_per_frame;
+	return _length > 0;
+}
+
+bool
+MappedAudioFile::parse_riff (bool rf64)
+{
+	if (memcmp (_map + 8, "WAVE", 4)) {
+		return false;
+	}
+
+	uint64_t ds64_data_size = 0;
+	size_t   pos            = 12;
+
+	while (pos + 8 <= _size) {
+		uint8_t const* chunk = _map + pos;
+		uint64_t       len   = le32 (chunk + 4);
+
+		pos += 8;
+
+		if (!memcmp (chunk, "ds64", 4)) {
+			if (len < 16 || pos + 16 > _size) {
+				return false;
+			}
+			ds64_data_size = le64 (_map + pos + 8);
+		} else if (!memcmp (chunk, "fmt ", 4)) {
+			if (len < 16 || pos + len > _size) {
+				return false;
+			}
+			uint8_t const* fmt         = _map + pos;
+			uint16_t       format      = le16 (fmt);
+			uint16_t const channels    = le16 (fmt + 2);
+			uint16_t const block_align = le16 (fmt + 12);
+			uint16_t const bits        = le16 (fmt + 14);
+
+			if (format == 0xfffe) {
+				/* WAVE_FORMAT_EXTENSIBLE, use sub-format */
+				if (len < 40) {
+					return false;
+				}
+				format = le16 (fmt + 24);
+			}
+			if (format != 1 && format != 3) {
+				return false;
+			}
+			if (!set_format (channels, bits, format == 3) || block_align != _bytes_per_frame) {
+				return false;
+			}
+		} else if (!memcmp (chunk, "data", 4)) {
+			if (rf64 && len == 0xffffffff) {
+				len = ds64_data_size;
+			}
+			return set_data (pos, len);
+		}
+
+		/* chunks are word aligned */
+		pos += len + (len & 1);
+	}
+	return false;
+}
+
+bool
+MappedAudioFile::parse_caf ()
+{
+	size_t pos = 8;
+
+	while (pos + 12 <= _size) {
+		uint8_t const* chunk = _map + pos;
+		int64_t        len   = (int64_t) be64 (chunk + 4);
+
+		pos += 12;
+
+		if (!memcmp (chunk, "desc", 4)) {
+			if (len < 32 || pos + 32 > _size) {
+				return false;
+			}
+			uint8_t const* desc = _map + pos;
+			if (memcmp (desc + 8, "lpcm", 4)) {
+				return false;
+			}
+			uint32_t const flags         = be32 (desc + 12);
+			uint32_t const bytes_per_pkt = be32 (desc + 16);
+			uint32_t const frames_per_pk = be32 (desc + 20);
+			uint32_t const channels      = be32 (desc + 24);
+			uint32_t const bits          = be32 (desc + 28);
+
+			/* kCAFLinearPCMFormatFlagIsFloat = 1, kCAFLinearPCMFormatFlagIsLittleEndian = 2 */
+			if (!(flags & 2) || frames_per_pk != 1) {
+				return false;
+			}
+			if (!set_format (channels, bits, flags & 1) || bytes_per_pkt != _bytes_per_frame) {
+				return false;
+			}
+		} else if (!memcmp (chunk, "data", 4)) {
+			/* skip edit-count, a size of -1 means "until the end of the file" */
+			if (len != -1 && len < 4) {
+				return false;
+			}
+			return set_data (pos + 4, len == -1 ? _size : len - 4);
+		}
+
+		if (len < 0) {
+			return false;
+		}
+		pos += len;
+	}
+	return false;
+}
+
+samplecnt_t
+MappedAudioFile::read (Sample* dst, samplepos_t start, samplecnt_t cnt, uint32_t channel, gain_t gain) const
+{
+	if (start >= _length || channel >= _channels) {
+		return 0;
+	}
+
+	cnt = std::min (cnt, _length - start);
+
+	uint8_t const*  p      = _data + start * _bytes_per_frame + channel * _bytes_per_sample;
+	uint32_t const  stride = _bytes_per_frame;
+
+	switch (_encoding) {
+		case Int16:
+			gain /= 32768.f;
+			for (samplecnt_t n = 0; n < cnt; ++n, p += stride) {
+				int16_t v;
+				memcpy (&v, p, sizeof (int16_t));
+				dst[n] = v * gain;
+			}
+			break;
+		case Int24:
+			gain /= 8388608.f;
+			for (samplecnt_t n = 0; n < cnt; ++n, p += stride) {
+				int32_t const v = (int32_t)(((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 24)) >> 8;
+				dst[n] = v * gain;
+			}
+			break;
+		case Float32:
+			if (_channels == 1 && gain == 1.f) {
+				memcpy (dst, p, cnt * sizeof (Sample));
+				break;
+			}
+			for (samplecnt_t n = 0; n < cnt; ++n, p += stride) {
+				float v;
+				memcpy (&v, p, sizeof (float));
+				dst[n] = v * gain;
+			}
+			break;
+	}
+
+	return cnt;
+}
+
+void
+MappedAudioFile::prefetch (samplepos_t start, samplecnt_t cnt) const
+{
+#ifndef PLATFORM_WINDOWS
+	if (start >= _length || cnt <= 0) {
+		return;
+	}
+
+	cnt = std::min (cnt, _length - start);
+
+	static size_t const page_size = sysconf (_SC_PAGESIZE);
+
+	size_t const first = (_data - _map) + start * _bytes_per_frame;
+	size_t const last  = first + cnt * _bytes_per_frame;
+	size_t const begin = first - (first % page_size);
+
+	madvise (_map + begin, last - begin, MADV_WILLNEED);
+#endif
+}
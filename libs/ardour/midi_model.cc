@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <limits>
 #include <set>
 #include <stdexcept>
 #include <stdint.h>
@@ -1458,7 +1459,7 @@ MidiModel::resolve_overlaps_unlocked (const NotePtr note, void* arg)
 	TimeType ea  = note->end_time();
 
 	const Pitches& p (pitches (note->channel()));
-	NotePtr search_note(new Note<TimeType>(0, TimeType(), TimeType(), note->note()));
+	NotePtr search_note(new Note<TimeType>(0, std::numeric_limits<TimeType>::lowest(), TimeType(), note->note()));
 	set<NotePtr> to_be_deleted;
 	bool set_note_length = false;
 	bool set_note_time = false;
@@ -1474,6 +1475,11 @@ MidiModel::resolve_overlaps_unlocked (const NotePtr note, void* arg)
 		TimeType eb = (*i)->end_time();
 		OverlapType overlap = OverlapNone;
 
+		if (sb > ea) {
+			/* pitches are sorted by time, no later note can overlap */
+			break;
+		}
+
 		if ((sb > sa) && (eb <= ea)) {
 			overlap = OverlapInternal;
 		} else if ((eb > sa) && (eb <= ea)) {
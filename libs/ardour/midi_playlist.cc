@@ -30,6 +30,7 @@
 
 #include "ardour/beats_samples_converter.h"
 #include "ardour/debug.h"
+#include "ardour/midi_channel_filter.h"
 #include "ardour/midi_model.h"
 #include "ardour/midi_playlist.h"
 #include "ardour/midi_region.h"
@@ -64,6 +65,7 @@ MidiPlaylist::MidiPlaylist (Session& session, const XMLNode& node, bool hidden)
 	in_set_state--;
 
 	relayer ();
+	init_render_cache ();
 }
 
 MidiPlaylist::MidiPlaylist (Session& session, string name, bool hidden)
@@ -71,6 +73,7 @@ MidiPlaylist::MidiPlaylist (Session& session, string name, bool hidden)
 	, _note_mode(Sustained)
 	, _read_end(0)
 {
+	init_render_cache ();
 }
 
 MidiPlaylist::MidiPlaylist (boost::shared_ptr<const MidiPlaylist> other, string name, bool hidden)
@@ -78,6 +81,7 @@ MidiPlaylist::MidiPlaylist (boost::shared_ptr<const MidiPlaylist> other, string
 	, _note_mode(other->_note_mode)
 	, _read_end(0)
 {
+	init_render_cache ();
 }
 
 MidiPlaylist::MidiPlaylist (boost::shared_ptr<const MidiPlaylist> other,
@@ -89,10 +93,12 @@ MidiPlaylist::MidiPlaylist (boost::shared_ptr<const MidiPlaylist> other,
 	, _note_mode(other->_note_mode)
 	, _read_end(0)
 {
+	init_render_cache ();
 }
 
 MidiPlaylist::~MidiPlaylist ()
 {
+	drop_render_cache ();
 }
 
 template<typename Time>
@@ -116,6 +122,49 @@ MidiPlaylist::remove_dependents (boost::shared_ptr<Region> region)
 {
 }
 
+void
+MidiPlaylist::init_render_cache ()
+{
+	_render_filter    = 0;
+	_render_note_mode = _note_mode;
+	_render_reset     = true;
+
+	/* events are rendered in samples. MetricPositionChanged is emitted
+	 * when dragging metrics, PropertyChanged for all other edits.
+	 */
+	_session.tempo_map ().PropertyChanged.connect_same_thread (*this, boost::bind (&MidiPlaylist::tempo_map_changed, this));
+	_session.tempo_map ().MetricPositionChanged.connect_same_thread (*this, boost::bind (&MidiPlaylist::tempo_map_changed, this));
+}
+
+/** caller must hold _render_lock */
+void
+MidiPlaylist::drop_render_cache ()
+{
+	for (RenderCache::iterator i = _render_cache.begin (); i != _render_cache.end (); ++i) {
+		for (RenderedEvents::iterator e = i->second.begin (); e != i->second.end (); ++e) {
+			delete *e;
+		}
+	}
+	_render_cache.clear ();
+}
+
+void
+MidiPlaylist::tempo_map_changed ()
+{
+	Glib::Threads::Mutex::Lock lm (_render_dirty_lock);
+	_render_reset = true;
+}
+
+bool
+MidiPlaylist::region_changed (const PBD::PropertyChange& what_changed, boost::shared_ptr<Region> region)
+{
+	{
+		Glib::Threads::Mutex::Lock lm (_render_dirty_lock);
+		_render_dirty.insert (region->id ());
+	}
+	return Playlist::region_changed (what_changed, region);
+}
+
 void
 MidiPlaylist::region_going_away (boost::weak_ptr<Region> region)
 {
@@ -298,16 +347,83 @@ MidiPlaylist::contained_automation()
 	return ret;
 }
 
+namespace {
+
+/** Position in the rendered events of a region, to merge regions */
+struct RenderCursor {
+	RenderCursor (Evoral::EventList<samplepos_t> const& ev, size_t o)
+		: pos (ev.begin ()), end (ev.end ()), order (o) {}
+
+	Evoral::EventList<samplepos_t>::const_iterator pos;
+	Evoral::EventList<samplepos_t>::const_iterator end;
+	size_t order;
+};
+
+/** heap-order: true if @a a is to be written after @a b */
+struct RenderCursorAfter {
+	bool operator() (RenderCursor const& a, RenderCursor const& b) {
+		if (cmp (*b.pos, *a.pos)) {
+			return true;
+		}
+		if (cmp (*a.pos, *b.pos)) {
+			return false;
+		}
+		/* same as a stable sort of all events in region order */
+		return a.order > b.order;
+	}
+	EventsSortByTimeAndType<samplepos_t> cmp;
+};
+
+}
+
 void
 MidiPlaylist::render (MidiChannelFilter* filter)
 {
-	typedef pair<MidiStateTracker*,samplepos_t> TrackerInfo;
-
 	Playlist::RegionReadLock rl (this);
+	Glib::Threads::Mutex::Lock lm (_render_lock);
 
 	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- MidiPlaylist::render (regions: %1)-----\n", regions.size()));
 
-	std::vector< boost::shared_ptr<Region> > regs;
+	uint32_t filter_state = 0;
+
+	if (filter) {
+		ChannelMode mode;
+		uint16_t    mask;
+		filter->get_mode_and_mask (&mode, &mask);
+		filter_state = ((uint32_t)mode << 16) | mask;
+	}
+
+	{
+		Glib::Threads::Mutex::Lock dl (_render_dirty_lock);
+
+		if (_render_reset || filter_state != _render_filter || _note_mode != _render_note_mode) {
+			drop_render_cache ();
+		} else {
+			for (std::set<PBD::ID>::const_iterator i = _render_dirty.begin (); i != _render_dirty.end (); ++i) {
+				RenderCache::iterator c = _render_cache.find (*i);
+				if (c != _render_cache.end ()) {
+					for (RenderedEvents::iterator e = c->second.begin (); e != c->second.end (); ++e) {
+						delete *e;
+					}
+					_render_cache.erase (c);
+				}
+			}
+		}
+
+		_render_dirty.clear ();
+		_render_reset = false;
+	}
+
+	_render_filter    = filter_state;
+	_render_note_mode = _note_mode;
+
+	/* Render regions that are not cached, and collect the events of
+	 * all regions. Regions that are no longer used remain in
+	 * _render_cache and are dropped below.
+	 */
+	RenderCache                  cache;
+	std::vector<RenderedEvents*> parts;
+	uint32_t                     n_rendered = 0;
 
 	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
 
@@ -317,60 +433,66 @@ MidiPlaylist::render (MidiChannelFilter* filter)
 			continue;
 		}
 
-		regs.push_back (*i);
-	}
-
-	/* If we are reading from a single region, we can read directly into _rendered.  Otherwise,
-	   we read into a temporarily list, sort it, then write that to _rendered.
-	*/
-	Evoral::EventList<samplepos_t>  evlist;
-	Evoral::EventSink<samplepos_t>* tgt;
+		boost::shared_ptr<MidiRegion> mr = boost::dynamic_pointer_cast<MidiRegion>(*i);
 
-	/* RAII */
-	RTMidiBuffer::WriteProtectRender wpr (_rendered);
+		if (!mr) {
+			continue;
+		}
 
-	if (regs.empty()) {
-		wpr.acquire ();
-		_rendered.clear ();
-	} else {
+		RenderedEvents&       ev (cache[mr->id ()]);
+		RenderCache::iterator c = _render_cache.find (mr->id ());
 
-		if (regs.size() == 1) {
-			tgt = &_rendered;
-			wpr.acquire ();
-			_rendered.clear ();
+		if (c != _render_cache.end ()) {
+			ev.swap (c->second);
 		} else {
-			tgt = &evlist;
+			DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("render from %1\n", mr->name()));
+			mr->render (ev, 0, _note_mode, filter);
+
+			EventsSortByTimeAndType<samplepos_t> cmp;
+			ev.sort (cmp);
+			++n_rendered;
 		}
 
-		DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("\t%1 regions to read, direct: %2\n", regs.size(), (regs.size() == 1)));
+		if (!ev.empty ()) {
+			parts.push_back (&ev);
+		}
+	}
 
-		for (vector<boost::shared_ptr<Region> >::iterator i = regs.begin(); i != regs.end(); ++i) {
+	drop_render_cache ();
+	_render_cache.swap (cache);
 
-			boost::shared_ptr<MidiRegion> mr = boost::dynamic_pointer_cast<MidiRegion>(*i);
+	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("\t%1 regions rendered, %2 regions cached\n", n_rendered, _render_cache.size () - n_rendered));
 
-			if (!mr) {
-				continue;
-			}
+	/* Merge the sorted events of all regions into _rendered */
 
-			DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("render from %1\n", mr->name()));
-			mr->render (*tgt, 0, _note_mode, filter);
-		}
+	std::vector<RenderCursor> heap;
+	heap.reserve (parts.size ());
 
-		if (!evlist.empty()) {
-			/* We've read from multiple regions into evlist, sort the event list by time. */
-			EventsSortByTimeAndType<samplepos_t> cmp;
-			evlist.sort (cmp);
+	for (size_t n = 0; n < parts.size (); ++n) {
+		heap.push_back (RenderCursor (*parts[n], n));
+	}
 
-			/* Copy ordered events from event list to _rendered. */
+	RenderCursorAfter after;
+	std::make_heap (heap.begin (), heap.end (), after);
 
-			wpr.acquire ();
-			_rendered.clear ();
+	/* RAII */
+	RTMidiBuffer::WriteProtectRender wpr (_rendered);
 
-			for (Evoral::EventList<samplepos_t>::iterator e = evlist.begin(); e != evlist.end(); ++e) {
-				Evoral::Event<samplepos_t>* ev (*e);
-				_rendered.write (ev->time(), ev->event_type(), ev->size(), ev->buffer());
-				delete ev;
-			}
+	wpr.acquire ();
+	_rendered.clear ();
+
+	while (!heap.empty ()) {
+		std::pop_heap (heap.begin (), heap.end (), after);
+
+		RenderCursor&               c  (heap.back ());
+		Evoral::Event<samplepos_t>* ev (*c.pos);
+
+		_rendered.write (ev->time(), ev->event_type(), ev->size(), ev->buffer());
+
+		if (++c.pos == c.end) {
+			heap.pop_back ();
+		} else {
+			std::push_heap (heap.begin (), heap.end (), after);
 		}
 	}
 
@@ -145,6 +145,93 @@ default_copy_vector (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t
 	memcpy(dst, src, nframes*sizeof(ARDOUR::Sample));
 }
 
+/* Multi-channel meter ballistics, see Kmeterdsp, Iec1ppmdsp, Iec2ppmdsp
+ * and Vumeterdsp. Filter state is passed per channel, samples are
+ * processed in groups of 4, any remainder is ignored.
+ */
+
+void
+default_kmeter_process (ARDOUR::Sample const* const* src, uint32_t n_chn, pframes_t nframes, float omega, float* z1, float* z2)
+{
+	for (uint32_t c = 0; c < n_chn; ++c) {
+		ARDOUR::Sample const* p = src[c];
+		float s;
+		float a = z1[c];
+		float b = z2[c];
+		for (pframes_t n = nframes / 4; n > 0; --n) {
+			s = *p++;
+			s *= s;
+			a += omega * (s - a);
+			s = *p++;
+			s *= s;
+			a += omega * (s - a);
+			s = *p++;
+			s *= s;
+			a += omega * (s - a);
+			s = *p++;
+			s *= s;
+			a += omega * (s - a);
+			b += 4 * omega * (a - b);
+		}
+		z1[c] = a;
+		z2[c] = b;
+	}
+}
+
+void
+default_ppm_process (ARDOUR::Sample const* const* src, uint32_t n_chn, pframes_t nframes, float w1, float w2, float w3, float* z1, float* z2, float* m)
+{
+	for (uint32_t c = 0; c < n_chn; ++c) {
+		ARDOUR::Sample const* p = src[c];
+		float t;
+		float a  = z1[c];
+		float b  = z2[c];
+		float pk = m[c];
+		for (pframes_t n = nframes / 4; n > 0; --n) {
+			a *= w3;
+			b *= w3;
+			for (int i = 0; i < 4; ++i) {
+				t = fabsf (*p++);
+				if (t > a) a += w1 * (t - a);
+				if (t > b) b += w2 * (t - b);
+			}
+			t = a + b;
+			if (t > pk) pk = t;
+		}
+		z1[c] = a;
+		z2[c] = b;
+		m[c]  = pk;
+	}
+}
+
+void
+default_vumeter_process (ARDOUR::Sample const* const* src, uint32_t n_chn, pframes_t nframes, float w, float* z1, float* z2, float* m)
+{
+	for (uint32_t c = 0; c < n_chn; ++c) {
+		ARDOUR::Sample const* p = src[c];
+		float t1, t2;
+		float a  = z1[c];
+		float b  = z2[c];
+		float pk = m[c];
+		for (pframes_t n = nframes / 4; n > 0; --n) {
+			t2 = b / 2;
+			t1 = fabsf (*p++) - t2;
+			a += w * (t1 - a);
+			t1 = fabsf (*p++) - t2;
+			a += w * (t1 - a);
+			t1 = fabsf (*p++) - t2;
+			a += w * (t1 - a);
+			t1 = fabsf (*p++) - t2;
+			a += w * (t1 - a);
+			b += 4 * w * (a - b);
+			if (b > pk) pk = b;
+		}
+		z1[c] = a;
+		z2[c] = b;
+		m[c]  = pk;
+	}
+}
+
 #if defined (__APPLE__) && defined (BUILD_VECLIB_OPTIMIZATIONS)
 #include <Accelerate/Accelerate.h>
 
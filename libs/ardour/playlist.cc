@@ -357,6 +357,7 @@ Playlist::init (bool hide)
 	_combine_ops                = 0;
 	_end_space                  = 0;
 	_playlist_shift_active      = false;
+	_region_writers             = 0;
 
 	_session.history ().BeginUndoRedo.connect_same_thread (*this, boost::bind (&Playlist::begin_undo, this));
 	_session.history ().EndUndoRedo.connect_same_thread (*this, boost::bind (&Playlist::end_undo, this));
@@ -787,6 +788,7 @@ Playlist::add_region_internal (boost::shared_ptr<Region> region, samplepos_t pos
 
 	regions.insert (upper_bound (regions.begin (), regions.end (), region, cmp), region);
 	all_regions.insert (region);
+	invalidate_region_index ();
 
 	possibly_splice_unlocked (position, region->length (), region, thawlist);
 
@@ -847,6 +849,7 @@ Playlist::remove_region_internal (boost::shared_ptr<Region> region, ThawList& th
 			samplecnt_t distance = (*i)->length ();
 
 			regions.erase (i);
+			invalidate_region_index ();
 
 			possibly_splice_unlocked (pos, -distance, boost::shared_ptr<Region> (), thawlist);
 
@@ -1725,6 +1728,12 @@ Playlist::region_changed_proxy (const PropertyChange& what_changed, boost::weak_
 		return;
 	}
 
+	if (what_changed.contains (Properties::position) || what_changed.contains (Properties::length)) {
+		invalidate_region_index ();
+	} else {
+		invalidate_playback_map ();
+	}
+
 	/* this makes a virtual call to the right kind of playlist ... */
 
 	region_changed (what_changed, region);
@@ -1860,6 +1869,84 @@ Playlist::deep_sources (std::set<boost::shared_ptr<Source> >& sources) const
 	}
 }
 
+bool
+Playlist::use_region_index () const
+{
+	/* Caller must hold the region lock and _region_index_lock */
+
+	if (_region_writers > 0) {
+		/* the list is being modified by this thread */
+		return false;
+	}
+
+	if (!_region_index.valid ()) {
+		_region_index.build (regions.rlist ());
+	}
+
+	return true;
+}
+
+/** Look up regions using the index, if it can be used.
+ * Caller must hold the region lock.
+ * @return true if @a rl was filled in, false if the region list needs to be scanned
+ */
+bool
+Playlist::query_region_index (RegionIndexQuery q, samplepos_t start, samplepos_t end, RegionList& rl) const
+{
+	Glib::Threads::Mutex::Lock lm (_region_index_lock);
+
+	if (!use_region_index ()) {
+		return false;
+	}
+
+	switch (q) {
+		case IndexTouched:
+			_region_index.touched (start, end, rl);
+			break;
+		case IndexStartWithin:
+			_region_index.start_within (start, end, rl);
+			break;
+		case IndexEndWithin:
+			_region_index.end_within (start, end, rl);
+			break;
+	}
+
+	return true;
+}
+
+/** Count regions covering @a sample using the index, if it can be used.
+ * Caller must hold the region lock.
+ * @return true if @a cnt was set, false if the region list needs to be scanned
+ */
+bool
+Playlist::count_region_index (samplepos_t sample, uint32_t& cnt) const
+{
+	Glib::Threads::Mutex::Lock lm (_region_index_lock);
+
+	if (!use_region_index ()) {
+		return false;
+	}
+
+	cnt = _region_index.count_at (sample);
+	return true;
+}
+
+void
+Playlist::region_extent_changed ()
+{
+	invalidate_region_index ();
+}
+
+void
+Playlist::invalidate_region_index ()
+{
+	{
+		Glib::Threads::Mutex::Lock lm (_region_index_lock);
+		_region_index.clear ();
+	}
+	invalidate_playback_map ();
+}
+
 boost::shared_ptr<RegionList>
 Playlist::regions_at (samplepos_t sample)
 {
@@ -1873,6 +1960,10 @@ Playlist::count_regions_at (samplepos_t sample) const
 	RegionReadLock rlock (const_cast<Playlist*> (this));
 	uint32_t       cnt = 0;
 
+	if (count_region_index (sample, cnt)) {
+		return cnt;
+	}
+
 	for (RegionList::const_iterator i = regions.begin (); i != regions.end (); ++i) {
 		if ((*i)->covers (sample)) {
 			cnt++;
@@ -1934,6 +2025,10 @@ Playlist::find_regions_at (samplepos_t sample)
 
 	boost::shared_ptr<RegionList> rlist (new RegionList);
 
+	if (query_region_index (IndexTouched, sample, sample, *rlist)) {
+		return rlist;
+	}
+
 	for (RegionList::iterator i = regions.begin (); i != regions.end (); ++i) {
 		if ((*i)->covers (sample)) {
 			rlist->push_back (*i);
@@ -1949,6 +2044,10 @@ Playlist::regions_with_start_within (Evoral::Range<samplepos_t> range)
 	RegionReadLock                rlock (this);
 	boost::shared_ptr<RegionList> rlist (new RegionList);
 
+	if (query_region_index (IndexStartWithin, range.from, range.to, *rlist)) {
+		return rlist;
+	}
+
 	for (RegionList::iterator i = regions.begin (); i != regions.end (); ++i) {
 		if ((*i)->first_sample () >= range.from && (*i)->first_sample () <= range.to) {
 			rlist->push_back (*i);
@@ -1964,6 +2063,10 @@ Playlist::regions_with_end_within (Evoral::Range<samplepos_t> range)
 	RegionReadLock                rlock (this);
 	boost::shared_ptr<RegionList> rlist (new RegionList);
 
+	if (query_region_index (IndexEndWithin, range.from, range.to, *rlist)) {
+		return rlist;
+	}
+
 	for (RegionList::iterator i = regions.begin (); i != regions.end (); ++i) {
 		if ((*i)->last_sample () >= range.from && (*i)->last_sample () <= range.to) {
 			rlist->push_back (*i);
@@ -1985,6 +2088,10 @@ Playlist::regions_touched_locked (samplepos_t start, samplepos_t end)
 {
 	boost::shared_ptr<RegionList> rlist (new RegionList);
 
+	if (query_region_index (IndexTouched, start, end, *rlist)) {
+		return rlist;
+	}
+
 	for (RegionList::iterator i = regions.begin (); i != regions.end (); ++i) {
 		if ((*i)->coverage (start, end) != Evoral::OverlapNone) {
 			rlist->push_back (*i);
@@ -2651,6 +2758,7 @@ Playlist::relayer ()
 	 * probably keep a note of the top layer last time we relayered, and check that,
 	 * but premature optimisation &c...
 	 */
+	invalidate_playback_map ();
 	notify_layering_changed ();
 
 	/* This relayer() may have been called as a result of a region removal, in which
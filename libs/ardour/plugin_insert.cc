@@ -43,6 +43,7 @@
 #include "ardour/plugin.h"
 #include "ardour/plugin_insert.h"
 #include "ardour/port.h"
+#include "ardour/rt_tasklist.h"
 
 #ifdef WINDOWS_VST_SUPPORT
 #include "ardour/windows_vst_plugin.h"
@@ -73,6 +74,9 @@ using namespace std;
 using namespace ARDOUR;
 using namespace PBD;
 
+/* minimum time saved by processing replicated plugin instances in parallel, in usec */
+static const float parallel_instances_usec = 50.f;
+
 const string PluginInsert::port_automation_node_name = "PortAutomation";
 
 PluginInsert::PluginInsert (Session& s, boost::shared_ptr<Plugin> plug)
@@ -84,9 +88,11 @@ PluginInsert::PluginInsert (Session& s, boost::shared_ptr<Plugin> plug)
 	, _signal_analysis_collect_nsamples_max (0)
 	, _configured (false)
 	, _no_inplace (false)
+	, _parallel_instances (false)
 	, _strict_io (false)
 	, _custom_cfg (false)
 	, _maps_from_state (false)
+	, _instance_dsp_usec (0)
 	, _latency_changed (false)
 	, _bypass_port (UINT32_MAX)
 	, _inverted_bypass_enable (false)
@@ -855,7 +861,7 @@ PluginInsert::inplace_silence_unconnected (BufferSet& bufs, const PinMappings& o
 }
 
 void
-PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t end, double speed, pframes_t nframes, samplecnt_t offset, bool with_auto)
+PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t end, double speed, pframes_t nframes, samplecnt_t offset, bool with_auto, bool sub_block_auto)
 {
 	// TODO: atomically copy maps & _no_inplace
 	const bool no_inplace = _no_inplace;
@@ -921,34 +927,37 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 				if (valid) {
 					c.set_value_unchecked(val);
 				}
-#if 0
-				/* 2. VST3: events between now and end. */
-				assert (_plugins.front()->requires_fixed_sized_buffers());
+
+				if (!sub_block_auto || clist->parameter().type() != PluginAutomation) {
+					continue;
+				}
+
+				/* 2. events between now and end, at their sample-offset */
 				samplepos_t now = start;
 				while (true) {
 					Evoral::ControlEvent next_event (end, 0.0f);
 					find_next_ac_event (*ci, now, end, next_event);
-					if (next_event.when >= end) {
+					if (ceil (next_event.when) >= end) {
 						break;
 					}
-					now = next_event.when;
-					const float val = c.list()->rt_safe_eval (now, valid);
+					now = ceil (next_event.when);
+					val = clist->rt_safe_eval (now, valid);
 					if (valid) {
 						for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
 							(*i)->set_parameter (clist->parameter().id(), val, now - start);
 						}
 					}
 				}
-#endif
-#if 0
-				/* 3. set value at cycle-end */
-				val = c.list()->rt_safe_eval (end, valid);
-				if (valid) {
-					for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
-						(*i)->set_parameter (clist->parameter().id(), val, end - start);
+
+				/* 3. value at the last sample of the cycle, the plugin interpolates */
+				if (nframes > 1 && now < end - 1) {
+					val = clist->rt_safe_eval (end - 1, valid);
+					if (valid) {
+						for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
+							(*i)->set_parameter (clist->parameter().id(), val, nframes - 1);
+						}
 					}
 				}
-#endif
 			}
 		}
 	}
@@ -1078,12 +1087,42 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 		}
 	} else {
 		/* in-place processing */
-		uint32_t pc = 0;
-		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i, ++pc) {
-			if ((*i)->connect_and_run(bufs, start, end, speed, in_map.p(pc), out_map.p(pc), nframes, offset)) {
-				deactivate ();
+		uint32_t const n_instances = _plugins.size ();
+
+		_instance_runner.plugins = &_plugins;
+		_instance_runner.in_map  = &in_map;
+		_instance_runner.out_map = &out_map;
+		_instance_runner.bufs    = &bufs;
+		_instance_runner.start   = start;
+		_instance_runner.end     = end;
+		_instance_runner.speed   = speed;
+		_instance_runner.nframes = nframes;
+		_instance_runner.offset  = offset;
+		g_atomic_int_set (&_instance_runner.failed, 0);
+
+		/* replicated instances use distinct buffers, they can be processed
+		 * in parallel if that is worth waking up other DSP threads */
+		boost::shared_ptr<RTTaskList> tl;
+		if (n_instances > 1 && _parallel_instances && bufs.count ().n_midi () == 0
+		    && _instance_dsp_usec * (n_instances - 1) > parallel_instances_usec) {
+			tl = _session.rt_tasklist ();
+		}
+
+		if (tl) {
+			tl->process (_instance_runner, n_instances);
+		} else {
+			for (uint32_t pc = 0; pc < n_instances; ++pc) {
+				_instance_runner.run_task (pc);
 			}
 		}
+
+		if (n_instances > 1) {
+			_instance_dsp_usec += .05f * ((float)_instance_runner.first_usec - _instance_dsp_usec);
+		}
+
+		if (g_atomic_int_get (&_instance_runner.failed)) {
+			deactivate ();
+		}
 		// now silence unconnected outputs
 		inplace_silence_unconnected (bufs, _out_map, nframes, offset);
 	}
@@ -1121,6 +1160,20 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 	}
 }
 
+void
+PluginInsert::InstanceRunner::run_task (uint32_t pc)
+{
+	uint64_t const t0 = pc == 0 ? PBD::get_microseconds () : 0;
+
+	if ((*plugins)[pc]->connect_and_run (*bufs, start, end, speed, in_map->p (pc), out_map->p (pc), nframes, offset)) {
+		g_atomic_int_set (&failed, 1);
+	}
+
+	if (pc == 0) {
+		first_usec = PBD::get_microseconds () - t0;
+	}
+}
+
 void
 PluginInsert::bypass (BufferSet& bufs, pframes_t nframes)
 {
@@ -1330,7 +1383,7 @@ PluginInsert::automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t
 	/* map start back into loop-range, adjust end */
 	map_loop_range (start, end);
 
-	if (!find_next_event (start, end, next_event) || _plugins.front()->requires_fixed_sized_buffers()) {
+	if (!find_next_event (start, end, next_event)) {
 
 		/* no events have a time within the relevant range */
 
@@ -1338,6 +1391,19 @@ PluginInsert::automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t
 		return;
 	}
 
+	if (can_automate_sub_block (end, speed)) {
+
+		/* the plugin handles parameter changes within the cycle */
+
+		connect_and_run (bufs, start, end, speed, nframes, offset, true, true);
+		return;
+	}
+
+	if (_plugins.front()->requires_fixed_sized_buffers()) {
+		connect_and_run (bufs, start, end, speed, nframes, offset, true);
+		return;
+	}
+
 	while (nframes) {
 
 		samplecnt_t cnt = min ((samplecnt_t) ceil (fabs (next_event.when - start)), (samplecnt_t) nframes);
@@ -1363,6 +1429,28 @@ PluginInsert::automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t
 	}
 }
 
+bool
+PluginInsert::can_automate_sub_block (samplepos_t end, double speed) const
+{
+	if (!Config->get_sample_accurate_plugin_automation () || !_plugins.front()->sample_accurate_automation ()) {
+		return false;
+	}
+
+	/* offsets are in samples, and the cycle must not wrap around the loop */
+	if (speed != 1.0 || (_loop_location && end > _loop_location->end ())) {
+		return false;
+	}
+
+	/* other automated controls are only evaluated at the start of the cycle */
+	boost::shared_ptr<ControlList> cl = _automated_controls.reader ();
+	for (ControlList::const_iterator ci = cl->begin(); ci != cl->end(); ++ci) {
+		if ((*ci)->parameter().type() != PluginAutomation && (*ci)->automation_playback()) {
+			return false;
+		}
+	}
+	return true;
+}
+
 float
 PluginInsert::default_parameter_value (const Evoral::Parameter& param)
 {
@@ -1639,9 +1727,45 @@ PluginInsert::mapping_changed ()
 {
 	PluginMapChanged (); /* EMIT SIGNAL */
 	_no_inplace = check_inplace ();
+	_parallel_instances = check_parallel ();
 	_session.set_dirty();
 }
 
+bool
+PluginInsert::check_parallel () const
+{
+	if (_no_inplace || get_count () < 2) {
+		return false;
+	}
+
+	/* Plugin::connect_and_run () injects immediate events and pending
+	 * note-offs into the first MIDI buffer, in every instance.
+	 */
+	if (_configured_internal.n_midi () > 0 || _configured_out.n_midi () > 0
+	    || natural_input_streams ().n_midi () > 0 || natural_output_streams ().n_midi () > 0) {
+		return false;
+	}
+
+	/* every buffer must only be used by a single instance */
+	std::map<DataType, std::map<uint32_t, uint32_t> > owner;
+
+	for (uint32_t pc = 0; pc < get_count (); ++pc) {
+		ChanMapping const* maps[2] = { &_in_map.p (pc), &_out_map.p (pc) };
+		for (int m = 0; m < 2; ++m) {
+			ChanMapping::Mappings const& mp (maps[m]->mappings ());
+			for (ChanMapping::Mappings::const_iterator t = mp.begin (); t != mp.end (); ++t) {
+				for (ChanMapping::TypeMapping::const_iterator c = t->second.begin (); c != t->second.end (); ++c) {
+					std::pair<std::map<uint32_t, uint32_t>::iterator, bool> rv = owner[t->first].insert (std::make_pair (c->second, pc));
+					if (!rv.second && rv.first->second != pc) {
+						return false;
+					}
+				}
+			}
+		}
+	}
+	return true;
+}
+
 bool
 PluginInsert::check_inplace ()
 {
@@ -2093,6 +2217,7 @@ PluginInsert::configure_io (ChanCount in, ChanCount out)
 	}
 
 	_no_inplace = check_inplace ();
+	_parallel_instances = check_parallel ();
 
 	/* only the "noinplace_buffers" thread buffers need to be this large,
 	 * this can be optimized. other buffers are fine with
@@ -81,6 +81,7 @@
 #include <glibmm/fileutils.h>
 
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
 #include "pbd/file_utils.h"
 #include "pbd/tokenizer.h"
 #include "pbd/whitespace.h"
@@ -1654,9 +1655,28 @@ PluginManager::vst3_discover_from_path (string const& path, bool cache_only)
 
 	find_paths_matching_filter (plugin_objects, paths, vst3_filter, 0, false, true, true);
 
+	/* scan all modules without an up-to-date cache file in parallel,
+	 * discovery below then only has to read the cache. */
+	vector<string> stale;
+	if (!cache_only && !vst3_scanner_bin_path.empty ()) {
+		for (vector<string>::iterator i = plugin_objects.begin(); i != plugin_objects.end (); ++i) {
+			string module_path = module_path_vst3 (*i);
+			if (module_path.empty () || vst3_is_blacklisted (module_path)) {
+				continue;
+			}
+			if (vst3_valid_cache_file (module_path).empty ()) {
+				stale.push_back (*i);
+			}
+		}
+		run_vst3_scanner_apps (stale);
+	}
+	std::set<string> const scanned (stale.begin (), stale.end ());
+
 	for (vector<string>::iterator i = plugin_objects.begin(); i != plugin_objects.end (); ++i) {
-		ARDOUR::PluginScanMessage(_("VST3"), *i, !(cache_only || cancelled()));
-		vst3_discover (*i, cache_only || cancelled ());
+		/* do not re-try modules that failed or timed out above */
+		bool const no_scan = cache_only || cancelled () || scanned.find (*i) != scanned.end ();
+		ARDOUR::PluginScanMessage(_("VST3"), *i, !no_scan);
+		vst3_discover (*i, no_scan);
 	}
 
 	return cancelled() ? -1 : 0;
@@ -1833,6 +1853,119 @@ PluginManager::run_vst3_scanner_app (std::string bundle_path) const
 	return true;
 }
 
+namespace {
+struct VST3ScannerProcess {
+	VST3ScannerProcess (std::string const& b, std::string const& m)
+		: bundle_path (b)
+		, module_path (m)
+		, scanner (0)
+		, started (0)
+	{}
+
+	~VST3ScannerProcess () {
+		/* joins the thread that reads the scanner's output */
+		delete scanner;
+		if (!output.empty ()) {
+			vst3_scanner_log (output, bundle_path);
+		}
+	}
+
+	/* called by the scanner's output reader thread, several
+	 * scanners run concurrently, their output is logged when done.
+	 */
+	void collect_output (std::string msg) {
+		output += msg;
+	}
+
+	std::string           bundle_path;
+	std::string           module_path;
+	ARDOUR::SystemExec*   scanner;
+	PBD::ScopedConnection log_connection;
+	gint64                started;
+	std::string           output;
+};
+}
+
+void
+PluginManager::run_vst3_scanner_apps (std::vector<std::string> const& bundle_paths) const
+{
+	/* scanning is mostly I/O and dynamic linking, but some
+	 * plugins do a lot of work on load. */
+	size_t const max_procs = std::max (1, std::min (8, (int) hardware_concurrency ()));
+
+	int  timeout = Config->get_vst_scan_timeout(); // deciseconds
+	bool notime  = (timeout <= 0);
+
+	std::list<VST3ScannerProcess*> running;
+	std::vector<std::string>::const_iterator next = bundle_paths.begin ();
+
+	while (!running.empty () || (next != bundle_paths.end () && !cancelled ())) {
+
+		while (running.size () < max_procs && next != bundle_paths.end () && !cancelled ()) {
+			std::string const& bundle_path (*next++);
+			VST3ScannerProcess* p = new VST3ScannerProcess (bundle_path, module_path_vst3 (bundle_path));
+
+			char **argp= (char**) calloc (5, sizeof (char*));
+			argp[0] = strdup (vst3_scanner_bin_path.c_str ());
+			argp[1] = strdup ("-q");
+			argp[2] = strdup ("-f");
+			argp[3] = strdup (bundle_path.c_str ());
+			argp[4] = 0;
+
+			p->scanner = new ARDOUR::SystemExec (vst3_scanner_bin_path, argp);
+			p->scanner->ReadStdout.connect_same_thread (p->log_connection, boost::bind (&VST3ScannerProcess::collect_output, p, _1));
+
+			ARDOUR::PluginScanMessage (_("VST3"), bundle_path, true);
+
+			/* remains blacklisted if the scanner crashes */
+			vst3_blacklist (p->module_path);
+
+			if (p->scanner->start (ARDOUR::SystemExec::MergeWithStdin)) {
+				PBD::error << string_compose (_("Cannot launch VST scanner app '%1': %2"), vst3_scanner_bin_path, strerror (errno)) << endmsg;
+				delete p;
+				continue;
+			}
+
+			p->started = g_get_monotonic_time ();
+			running.push_back (p);
+		}
+
+		Glib::usleep (10000);
+
+		if (!notime && no_timeout ()) {
+			notime = true;
+		}
+
+		gint64 const now    = g_get_monotonic_time ();
+		gint64       oldest = now;
+
+		for (std::list<VST3ScannerProcess*>::iterator i = running.begin (); i != running.end ();) {
+			VST3ScannerProcess* p = *i;
+
+			if (p->scanner->is_running ()) {
+				if (!cancelled () && (notime || now - p->started < timeout * 100000)) {
+					oldest = std::min (oldest, p->started);
+					++i;
+					continue;
+				}
+				p->scanner->terminate ();
+				/* may be partially written */
+				g_unlink (vst3_cache_file (p->module_path).c_str ());
+				vst3_whitelist (p->module_path);
+			} else if (!vst3_valid_cache_file (p->module_path).empty ()) {
+				vst3_whitelist (p->module_path);
+			}
+
+			delete p;
+			i = running.erase (i);
+		}
+
+		if (!running.empty ()) {
+			ARDOUR::PluginScanTimeout (notime ? -1 : timeout - (int)((now - oldest) / 100000));
+		}
+	}
+}
+
 #endif // VST3_SUPPORT
 
 
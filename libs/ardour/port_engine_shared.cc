@@ -18,11 +18,15 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <cstring>
+
 #include <regex.h>
 
 #include "pbd/error.h"
 
 #include "ardour/port_engine_shared.h"
+#include "ardour/runtime_functions.h"
 
 #include "pbd/i18n.h"
 
@@ -32,6 +36,8 @@ BackendPort::BackendPort (PortEngineSharedImpl &b, const std::string& name, Port
 	: _backend (b)
 	, _name  (name)
 	, _flags (flags)
+	, _connection_list (new ConnectionList)
+	, _dropped_midi_events (0)
 {
 	_capture_latency_range.min = 0;
 	_capture_latency_range.max = 0;
@@ -96,6 +102,7 @@ void
 BackendPort::store_connection (BackendPortHandle port)
 {
 	_connections.insert (port);
+	update_connection_list ();
 }
 
 int
@@ -125,6 +132,7 @@ void BackendPort::remove_connection (BackendPortHandle port)
 	std::set<BackendPortPtr>::iterator it = _connections.find (port);
 	assert (it != _connections.end ());
 	_connections.erase (it);
+	update_connection_list ();
 }
 
 
@@ -136,6 +144,70 @@ void BackendPort::disconnect_all (BackendPortHandle self)
 		_backend.port_connect_callback (name(), (*it)->name(), false);
 		_connections.erase (it);
 	}
+	update_connection_list ();
+}
+
+void
+BackendPort::update_connection_list ()
+{
+	gint const dropped = g_atomic_int_get (&_dropped_midi_events);
+	if (dropped > 0) {
+		g_atomic_int_add (&_dropped_midi_events, -dropped);
+		PBD::warning << string_compose (_("BackendPort: MIDI buffer of '%1' was full, dropped %2 events."), name (), dropped) << endmsg;
+	}
+
+	RCUWriter<ConnectionList> writer (_connection_list);
+	boost::shared_ptr<ConnectionList> cl = writer.get_copy ();
+
+	cl->clear ();
+	for (std::set<BackendPortPtr>::const_iterator it = _connections.begin (); it != _connections.end (); ++it) {
+		cl->push_back (it->get ());
+	}
+}
+
+Sample*
+BackendPort::mix_connections (Sample* buf, pframes_t n_samples)
+{
+	boost::shared_ptr<ConnectionList> cl = _connection_list.reader ();
+
+	ConnectionList::const_iterator it = cl->begin ();
+
+	if (it == cl->end ()) {
+		memset (buf, 0, n_samples * sizeof (Sample));
+		return buf;
+	}
+
+	assert ((*it)->is_output () && (*it)->type () == DataType::AUDIO);
+	Sample* src = static_cast<Sample*> ((*it)->get_buffer (n_samples));
+
+	if (cl->size () == 1) {
+		/* zero-copy, like JACK does */
+		return src;
+	}
+
+	copy_vector (buf, src, n_samples);
+
+	while (++it != cl->end ()) {
+		assert ((*it)->is_output () && (*it)->type () == DataType::AUDIO);
+		mix_buffers_no_gain (buf, static_cast<Sample const*> ((*it)->get_buffer (n_samples)), n_samples);
+	}
+	return buf;
+}
+
+void
+BackendPort::merge_connections (BackendMidiBuffer& buf, pframes_t n_samples)
+{
+	boost::shared_ptr<ConnectionList> cl = _connection_list.reader ();
+
+	buf.clear ();
+	for (ConnectionList::const_iterator it = cl->begin (); it != cl->end (); ++it) {
+		assert ((*it)->is_output () && (*it)->type () == DataType::MIDI);
+		size_t const dropped = buf.merge (*static_cast<BackendMidiBuffer const*> ((*it)->get_buffer (n_samples)));
+		if (dropped > 0) {
+			/* do not print from the process thread */
+			g_atomic_int_add (&_dropped_midi_events, dropped);
+		}
+	}
 }
 
 bool
@@ -724,3 +796,136 @@ PortEngineSharedImpl::update_system_port_latencies ()
 		(*it)->update_connected_latency (false);
 	}
 }
+
+BackendMidiBuffer::BackendMidiBuffer (size_t max_events, size_t max_data)
+	: _data (max_data)
+	, _used (0)
+	, _max_events (max_events)
+{
+	_events.reserve (max_events);
+	_scratch.reserve (max_events);
+}
+
+BackendMidiBuffer::BackendMidiBuffer (BackendMidiBuffer const& other)
+	: _data (other._data.size ())
+	, _used (0)
+	, _max_events (other._max_events)
+{
+	_events.reserve (_max_events);
+	_scratch.reserve (_max_events);
+	merge (other);
+}
+
+void
+BackendMidiBuffer::clear ()
+{
+	_events.clear ();
+	_used = 0;
+}
+
+bool
+BackendMidiBuffer::push_back (pframes_t timestamp, uint8_t const* data, size_t size)
+{
+	if (_events.size () >= _max_events || _used + size > _data.size ()) {
+		return false;
+	}
+
+	Event const ev = { timestamp, (uint32_t) size, (uint32_t) _used };
+
+	if (size > 0) {
+		memcpy (&_data[_used], data, size);
+		_used += size;
+	}
+
+	if (_events.empty () || _events.back ().timestamp <= timestamp) {
+		_events.push_back (ev);
+	} else {
+		/* within reserved capacity, this does not allocate */
+		_events.insert (std::upper_bound (_events.begin (), _events.end (), ev, EventSorter ()), ev);
+	}
+	return true;
+}
+
+/** Return the header of an event of @param src as it is stored in this buffer.
+ * With @param bulk all of the source's data has been copied at @param base,
+ * otherwise the event's data is copied now.
+ */
+BackendMidiBuffer::Event
+BackendMidiBuffer::adopt (BackendMidiBuffer const& src, Event const& e, bool bulk, uint32_t base)
+{
+	if (bulk) {
+		Event const ev = { e.timestamp, e.size, e.offset + base };
+		return ev;
+	}
+
+	Event const ev = { e.timestamp, e.size, (uint32_t) _used };
+	if (e.size > 0) {
+		memcpy (&_data[_used], &src._data[e.offset], e.size);
+		_used += e.size;
+	}
+	return ev;
+}
+
+size_t
+BackendMidiBuffer::merge (BackendMidiBuffer const& src)
+{
+	if (src.empty ()) {
+		return 0;
+	}
+
+	size_t n = src.size ();
+
+	if (_events.size () + n > _max_events || _used + src._used > _data.size ()) {
+		/* add the earliest events that fit */
+		size_t used = _used;
+		for (n = 0; n < src.size () && _events.size () + n < _max_events; ++n) {
+			if (used + src._events[n].size > _data.size ()) {
+				break;
+			}
+			used += src._events[n].size;
+		}
+		if (n == 0) {
+			return src.size ();
+		}
+	}
+
+	bool const     bulk = (n == src.size ());
+	uint32_t const base = _used;
+
+	if (bulk && src._used > 0) {
+		memcpy (&_data[_used], &src._data[0], src._used);
+		_used += src._used;
+	}
+
+	std::vector<Event>::const_iterator       s   = src._events.begin ();
+	std::vector<Event>::const_iterator const end = s + n;
+
+	if (_events.empty () || _events.back ().timestamp <= s->timestamp) {
+		/* common case: append */
+		for (; s != end; ++s) {
+			_events.push_back (adopt (src, *s, bulk, base));
+		}
+		return src.size () - n;
+	}
+
+	/* both are sorted, merge headers */
+	_scratch.clear ();
+
+	std::vector<Event>::const_iterator d = _events.begin ();
+	while (d != _events.end () && s != end) {
+		if (s->timestamp < d->timestamp) {
+			_scratch.push_back (adopt (src, *s++, bulk, base));
+		} else {
+			_scratch.push_back (*d++);
+		}
+	}
+	for (; d != _events.end (); ++d) {
+		_scratch.push_back (*d);
+	}
+	for (; s != end; ++s) {
+		_scratch.push_back (adopt (src, *s, bulk, base));
+	}
+
+	_events.swap (_scratch);
+	return src.size () - n;
+}
@@ -145,6 +145,7 @@ PortManager::PortManager ()
 	, _audio_input_ports (new AudioInputPorts)
 	, _midi_input_ports (new MIDIInputPorts)
 	, _reset_meters (0)
+	, _input_resampler (new InputResampler)
 {
 	load_port_info ();
 }
@@ -522,6 +523,9 @@ PortManager::register_port (DataType dtype, const string& portname, bool input,
 		throw PortRegistrationFailure (string_compose ("unable to create port '%1': %2", portname, _("(unknown error)")));
 	}
 
+	/* avoid allocations in cycle_start() */
+	reserve_input_resampler (ports.reader ()->size ());
+
 	DEBUG_TRACE (DEBUG::Ports, string_compose ("\t%2 port registration success, ports now = %1\n", ports.reader()->size(), this));
 	return newport;
 }
@@ -1023,40 +1027,84 @@ PortManager::cycle_start (pframes_t nframes, Session* s)
 
 	_cycle_ports = ports.reader ();
 
-	/* TODO optimize
-	 *  - when speed == 1.0, the resampler copies data without processing
-	 *   it may (or may not) be more efficient to just run all in sequence.
+	/* 'lightweight' ports are processed in sequence:
+	 *  - output ports (sends_output()) only prepare their buffer
+	 *  - midi-ports only scale event timestamps
+	 *  - internal audio inputs are silenced
 	 *
-	 *  - single sequential task for 'lightweight' tasks would make sense
-	 *    (run it in parallel with 'heavy' resampling.
-	 *    * output ports (sends_output()) only set a flag
-	 *    * midi-ports only scale event timestamps
+	 * Externally connected audio inputs are resampled, with vari-speed
+	 * in parallel. A single external source-port may be connected to
+	 * many ardour input-ports: inputs that are handed the same engine
+	 * buffer (e.g. JACK passes the source-port's buffer to each input
+	 * that has only one connection) are resampled once, and the result
+	 * is copied to the other inputs.
 	 *
-	 *  - a threshold parallel vs searial processing may be appropriate.
-	 *    amount of work (how many connected ports are there, how
-	 *    many resamplers need to run) vs. available CPU cores and semaphore
-	 *    synchronization overhead.
+	 * TODO optimize
+	 *  - when speed == 1.0, the resampler copies data without processing
+	 *   it may (or may not) be more efficient to just copy the data.
 	 *
-	 *  - input ports: it would make sense to resample each input only once
-	 *    (rather than resample into each ardour-owned input port).
-	 *    A single external source-port may be connected to many ardour
-	 *    input-ports. Currently re-sampling is per input.
+	 *  - a threshold parallel vs searial processing may be appropriate.
+	 *    amount of work (how many resamplers need to run) vs. available
+	 *    CPU cores and semaphore synchronization overhead.
 	 */
-	if (s && s->rt_tasklist () && fabs (Port::speed_ratio ()) != 1.0) {
-		RTTaskList::TaskList tl;
-		for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-			if (!(p->second->flags() & TransportSyncPort)) {
-				tl.push_back (boost::bind (&Port::cycle_start, p->second, nframes));
-			}
+	const bool parallel = s && s->rt_tasklist () && fabs (Port::speed_ratio ()) != 1.0;
+
+	boost::shared_ptr<InputResampler> ir = _input_resampler.reader ();
+
+	std::vector<std::pair<Sample const*, AudioPort*> >&    resampled (ir->inputs);
+	std::vector<std::pair<AudioPort*, AudioPort const*> >& shared (ir->shared_inputs);
+
+	resampled.clear ();
+	shared.clear ();
+	ir->nframes = nframes;
+
+	for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
+		Port* port = p->second.get ();
+
+		if (port->flags() & TransportSyncPort) {
+			continue;
 		}
-		s->rt_tasklist()->process (tl);
-	} else {
-		for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-			if (!(p->second->flags() & TransportSyncPort)) {
-				p->second->cycle_start (nframes);
+
+		if (port->type () != DataType::AUDIO || port->sends_output () || !port->externally_connected ()) {
+			port->cycle_start (nframes);
+			continue;
+		}
+
+		AudioPort*    ap  = static_cast<AudioPort*> (port);
+		Sample const* src = ap->engine_get_input_buffer (nframes);
+
+		std::vector<std::pair<Sample const*, AudioPort*> >::const_iterator r;
+		for (r = resampled.begin (); r != resampled.end (); ++r) {
+			if (r->first == src) {
+				break;
 			}
 		}
+
+		if (r != resampled.end ()) {
+			shared.push_back (std::make_pair (ap, r->second));
+			continue;
+		}
+
+		resampled.push_back (std::make_pair (src, ap));
+
+		if (!parallel) {
+			ap->resample_input (src, nframes);
+		}
 	}
+
+	if (parallel) {
+		s->rt_tasklist()->process (*ir, resampled.size ());
+	}
+
+	for (std::vector<std::pair<AudioPort*, AudioPort const*> >::const_iterator i = shared.begin (); i != shared.end (); ++i) {
+		i->first->share_resampled_input (*i->second);
+	}
+}
+
+void
+PortManager::InputResampler::run_task (uint32_t i)
+{
+	inputs[i].second->resample_input (inputs[i].first, nframes);
 }
 
 void
@@ -1637,6 +1685,31 @@ PortManager::set_port_buffer_sizes (pframes_t n)
 	for (Ports::iterator p = all->begin(); p != all->end(); ++p) {
 		p->second->set_buffer_size (n);
 	}
+
+	reserve_input_resampler (all->size ());
+}
+
+/** Make room for @param n_ports in the lists used by cycle_start(),
+ * which runs concurrently and must not allocate. The lists are
+ * replaced rather than grown, the process thread may be using them.
+ */
+void
+PortManager::reserve_input_resampler (size_t n_ports)
+{
+	{
+		boost::shared_ptr<InputResampler const> cur = _input_resampler.reader ();
+
+		if (cur->inputs.capacity () >= n_ports && cur->shared_inputs.capacity () >= n_ports) {
+			return;
+		}
+	}
+
+	RCUWriter<InputResampler> writer (_input_resampler);
+	boost::shared_ptr<InputResampler> ir = writer.get_copy ();
+
+	/* leave headroom, ports are usually added in batches */
+	ir->inputs.reserve (2 * n_ports);
+	ir->shared_inputs.reserve (2 * n_ports);
 }
 
 bool
@@ -1487,7 +1487,17 @@ Region::send_change (const PropertyChange& what_changed)
 
 	Stateful::send_change (what_changed);
 
-	if (!Stateful::property_changes_suspended()) {
+	if (Stateful::property_changes_suspended()) {
+		/* the playlist is only notified when changes are resumed,
+		 * but its region index must not use the previous extent.
+		 */
+		if (what_changed.contains (Properties::position) || what_changed.contains (Properties::length)) {
+			boost::shared_ptr<Playlist> pl (_playlist.lock ());
+			if (pl) {
+				pl->region_extent_changed ();
+			}
+		}
+	} else {
 
 		/* Try and send a shared_pointer unless this is part of the constructor.
 		   If so, do nothing.
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include "ardour/region.h"
+#include "ardour/region_index.h"
+
+using namespace ARDOUR;
+
+namespace {
+
+struct Collector {
+	Collector (RegionList& r) : rl (r) {}
+	template<typename E> void operator() (E const& e) { rl.push_back (e.region); }
+	RegionList& rl;
+};
+
+struct Counter {
+	Counter () : cnt (0) {}
+	template<typename E> void operator() (E const&) { ++cnt; }
+	uint32_t cnt;
+};
+
+struct EndCollector {
+	EndCollector (RegionList& r, samplepos_t e) : rl (r), end (e) {}
+	template<typename E> void operator() (E const& e) { if (e.last <= end) { rl.push_back (e.region); } }
+	RegionList& rl;
+	samplepos_t end;
+};
+
+}
+
+RegionIndex::Entry::Entry (boost::shared_ptr<Region> const& r)
+	: first (r->first_sample ())
+	, last (r->last_sample ())
+	, max_last (last)
+	, region (r)
+{
+}
+
+RegionIndex::RegionIndex ()
+	: _valid (false)
+{
+}
+
+void
+RegionIndex::clear ()
+{
+	_entries.clear ();
+	_valid = false;
+}
+
+void
+RegionIndex::build (RegionList const& rl)
+{
+	_entries.clear ();
+	_entries.reserve (rl.size ());
+
+	for (RegionList::const_iterator i = rl.begin (); i != rl.end (); ++i) {
+		/* empty regions neither cover nor touch anything */
+		if ((*i)->length () > 0) {
+			_entries.push_back (Entry (*i));
+		}
+	}
+
+	/* the region-list is usually sorted already, stable sort retains
+	 * its order for regions at the same position.
+	 */
+	std::stable_sort (_entries.begin (), _entries.end (), EntrySorter ());
+
+	augment (0, _entries.size ());
+	_valid = true;
+}
+
+samplepos_t
+RegionIndex::augment (size_t lo, size_t hi)
+{
+	if (lo >= hi) {
+		return -1;
+	}
+
+	size_t const mid = lo + (hi - lo) / 2;
+	Entry&       e   = _entries[mid];
+
+	e.max_last = std::max (e.last, std::max (augment (lo, mid), augment (mid + 1, hi)));
+	return e.max_last;
+}
+
+template<typename Visitor>
+void
+RegionIndex::visit (size_t lo, size_t hi, samplepos_t start, samplepos_t end, Visitor& v) const
+{
+	if (lo >= hi) {
+		return;
+	}
+
+	size_t const mid = lo + (hi - lo) / 2;
+	Entry const& e   = _entries[mid];
+
+	if (e.max_last < start) {
+		/* nothing in this subtree reaches start */
+		return;
+	}
+
+	visit (lo, mid, start, end, v);
+
+	if (e.first > end) {
+		/* neither does this node nor its right subtree */
+		return;
+	}
+
+	if (e.last >= start) {
+		v (e);
+	}
+
+	visit (mid + 1, hi, start, end, v);
+}
+
+void
+RegionIndex::touched (samplepos_t start, samplepos_t end, RegionList& rl) const
+{
+	Collector c (rl);
+	visit (0, _entries.size (), start, end, c);
+}
+
+uint32_t
+RegionIndex::count_at (samplepos_t sample) const
+{
+	Counter c;
+	visit (0, _entries.size (), sample, sample, c);
+	return c.cnt;
+}
+
+void
+RegionIndex::end_within (samplepos_t start, samplepos_t end, RegionList& rl) const
+{
+	EndCollector c (rl, end);
+	visit (0, _entries.size (), start, end, c);
+}
+
+void
+RegionIndex::start_within (samplepos_t start, samplepos_t end, RegionList& rl) const
+{
+	/* entries are sorted by position: this is a contiguous range */
+	size_t lo = 0;
+	size_t hi = _entries.size ();
+
+	while (lo < hi) {
+		size_t const mid = lo + (hi - lo) / 2;
+		if (_entries[mid].first < start) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	for (; lo < _entries.size () && _entries[lo].first <= end; ++lo) {
+		rl.push_back (_entries[lo].region);
+	}
+}
@@ -63,6 +63,7 @@
 #include "ardour/disk_writer.h"
 #include "ardour/event_type_map.h"
 #include "ardour/gain_control.h"
+#include "ardour/graph.h"
 #include "ardour/internal_return.h"
 #include "ardour/internal_send.h"
 #include "ardour/meter.h"
@@ -475,7 +476,15 @@ Route::process_output_buffers (BufferSet& bufs,
 
 	samplecnt_t latency = 0;
 
-	for (ProcessorList::const_iterator i = _processors.begin(); i != _processors.end(); ++i) {
+	const bool parallel_sends = graph () && Config->get_intra_route_parallelism ();
+
+	size_t n = 0;
+
+	for (ProcessorList::const_iterator i = _processors.begin(); i != _processors.end(); ++i, ++n) {
+
+		if (parallel_sends && process_send_branches (i, n, bufs, start_sample, end_sample, speed, nframes, latency)) {
+			continue;
+		}
 
 		bool re_inject_oob_data = false;
 		if ((*i) == _disk_reader) {
@@ -544,6 +553,83 @@ Route::process_output_buffers (BufferSet& bufs,
 	}
 }
 
+/** Process a sequence of consecutive sends starting at @a i concurrently.
+ * Sends only read the route's buffers (unless thru latency-compensation
+ * is in effect), so they are independent branches of the signal flow.
+ *
+ * @param i current processor, on success set to the last send that was processed
+ * @param n index of @a i in the processor list, advanced along with it
+ * @param latency accumulated latency, updated as the sends are processed
+ * @return true if two or more sends were processed
+ */
+bool
+Route::process_send_branches (ProcessorList::const_iterator& i, size_t& n, BufferSet& bufs,
+                              samplepos_t start_sample, samplepos_t end_sample,
+                              double speed, pframes_t nframes, samplecnt_t& latency)
+{
+	std::vector<Send*> const& sends (_send_branches.sends);
+
+	if (n + 1 >= sends.size () || !sends[n] || !sends[n + 1]) {
+		/* fewer than two consecutive sends */
+		return false;
+	}
+
+	ProcessorList::const_iterator last = i;
+	samplecnt_t l = latency;
+
+	_send_branches.branches.clear ();
+
+	size_t s = n;
+	for (ProcessorList::const_iterator p = i; p != _processors.end () && s < sends.size (); ++p, ++s) {
+		Send* send = sends[s];
+		/* the cache is only valid while the processor list is unchanged */
+		if (!send || send != p->get () || !send->is_branch () || _send_branches.branches.size () == _send_branches.branches.capacity ()) {
+			break;
+		}
+
+		if (send->active ()) {
+			l += send->effective_latency ();
+		}
+
+		SendBranches::Branch b;
+		b.send            = send;
+		b.result_required = *p != _processors.back ();
+		if (speed < 0) {
+			b.start_sample = start_sample + l;
+			b.end_sample   = end_sample + l;
+		} else {
+			b.start_sample = start_sample - l;
+			b.end_sample   = end_sample - l;
+		}
+		_send_branches.branches.push_back (b);
+		last = p;
+	}
+
+	if (_send_branches.branches.size () < 2) {
+		return false;
+	}
+
+	_send_branches.bufs    = &bufs;
+	_send_branches.speed   = speed;
+	_send_branches.nframes = nframes;
+
+	graph ()->process_tasks (_send_branches, _send_branches.branches.size ());
+
+	bufs.set_count ((*last)->output_streams ());
+
+	latency = l;
+	n += _send_branches.branches.size () - 1;
+	i = last;
+	return true;
+}
+
+void
+Route::SendBranches::run_task (uint32_t n)
+{
+	Branch const& b (branches[n]);
+	b.send->run (*bufs, b.start_sample, b.end_sample, speed, nframes, b.result_required);
+}
+
 void
 Route::bounce_process (BufferSet& buffers, samplepos_t start, samplecnt_t nframes,
 		boost::shared_ptr<Processor> endpoint,
@@ -1974,6 +2060,13 @@ Route::configure_processors_unlocked (ProcessorStreams* err, Glib::Threads::RWLo
 	*/
 	_session.ensure_buffers (n_process_buffers ());
 
+	/* look up sends once, and pre-allocate space for concurrent processing */
+	_send_branches.sends.clear ();
+	for (ProcessorList::const_iterator p = _processors.begin (); p != _processors.end (); ++p) {
+		_send_branches.sends.push_back (dynamic_cast<Send*> (p->get ()));
+	}
+	_send_branches.branches.reserve (_processors.size ());
+
 	DEBUG_TRACE (DEBUG::Processors, string_compose ("%1: configuration complete\n", _name));
 
 	_in_configure_processors = false;
@@ -3317,15 +3410,22 @@ Route::add_send_to_internal_return (InternalSend* send)
 void
 Route::remove_send_from_internal_return (InternalSend* send)
 {
-	Glib::Threads::RWLock::ReaderLock rm (_processor_lock);
+	boost::shared_ptr<InternalReturn> d;
 
-	for (ProcessorList::const_iterator x = _processors.begin(); x != _processors.end(); ++x) {
-		boost::shared_ptr<InternalReturn> d = boost::dynamic_pointer_cast<InternalReturn>(*x);
+	{
+		Glib::Threads::RWLock::ReaderLock rm (_processor_lock);
 
-		if (d) {
-			return d->remove_send (send);
+		for (ProcessorList::const_iterator x = _processors.begin(); x != _processors.end() && !d; ++x) {
+			d = boost::dynamic_pointer_cast<InternalReturn>(*x);
 		}
 	}
+
+	/* this may wait for the process lock, which is taken
+	 * before the processor lock elsewhere.
+	 */
+	if (d) {
+		d->remove_send (send);
+	}
 }
 
 void
@@ -262,6 +262,12 @@ Send::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sample, do
 	/* _active was set to _pending_active by Delivery::run() */
 }
 
+bool
+Send::is_branch () const
+{
+	return _thru_delay->passthrough ();
+}
+
 XMLNode&
 Send::state ()
 {
@@ -529,8 +529,6 @@ Session::immediately_post_engine ()
 	 * session or set state for an existing one.
 	 */
 
-	_rt_tasklist.reset (new RTTaskList ());
-
 	if (how_many_dsp_threads () > 1) {
 		/* For now, only create the graph if we are using >1 DSP threads, as
 		   it is a bit slower than the old code with 1 thread.
@@ -538,6 +536,9 @@ Session::immediately_post_engine ()
 		_process_graph.reset (new Graph (*this));
 	}
 
+	/* uses the DSP threads of the graph, if any */
+	_rt_tasklist.reset (new RTTaskList (_process_graph));
+
 	/* every time we reconnect, recompute worst case output latencies */
 
 	_engine.Running.connect_same_thread (*this, boost::bind (&Session::initialize_latencies, this));
@@ -2250,8 +2251,8 @@ Session::resort_routes_using (boost::shared_ptr<RouteList> r)
 		/* We got a satisfactory topological sort, so there is no feedback;
 		   use this new graph.
 
-		   Note: the process graph rechain does not require a
-		   topologically-sorted list, but hey ho.
+		   Note: the process graph rechain relies on a
+		   topologically-sorted list to prioritize nodes.
 		*/
 		if (_process_graph) {
 			_process_graph->rechain (sorted_routes, edges);
@@ -71,6 +71,7 @@
 #include <glibmm/fileutils.h>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/scoped_array.hpp>
 
 #include "midi++/mmc.h"
 #include "midi++/port.h"
@@ -78,6 +79,7 @@
 #include "evoral/SMF.h"
 
 #include "pbd/basename.h"
+#include "pbd/cpus.h"
 #include "pbd/debug.h"
 #include "pbd/enumwriter.h"
 #include "pbd/error.h"
@@ -2370,6 +2372,138 @@ Session::reset_write_sources (bool mark_write_complete, bool force)
 	}
 }
 
+namespace {
+
+/** Reads the beginning of the files of a list of Source nodes, using a
+ * few threads. This runs concurrently with, and ahead of, the creation of
+ * the sources (which has to happen one after another), so that their file
+ * meta-data and headers are already cached instead of the session load
+ * waiting for the storage to respond for each file in turn.
+ */
+class SourceFilePrefetcher
+{
+public:
+	SourceFilePrefetcher (Session&, XMLNodeList const&, int32_t n_threads);
+	~SourceFilePrefetcher ();
+
+private:
+	struct Entry {
+		Entry (std::string const& p, bool w) : path (p), whole_file (w) {}
+		std::string path;
+		bool        whole_file;
+	};
+
+	static void* _thread (void*);
+	void thread ();
+	void read_file (Entry const&, char* buf, size_t bufsize) const;
+
+	std::vector<Entry>     _entries;
+	gint                   _next; // atomic
+	std::vector<pthread_t> _threads;
+};
+
+SourceFilePrefetcher::SourceFilePrefetcher (Session& s, XMLNodeList const& nlist, int32_t n_threads)
+	: _next (0)
+{
+	if (n_threads <= 0 || nlist.size () < 2) {
+		return;
+	}
+
+	std::vector<std::string> const audio_dirs = s.source_search_path (DataType::AUDIO);
+	std::vector<std::string> const midi_dirs  = s.source_search_path (DataType::MIDI);
+
+	for (XMLNodeConstIterator i = nlist.begin (); i != nlist.end (); ++i) {
+		std::string name;
+
+		if ((*i)->name () != X_("Source") || (*i)->property (X_("playlist")) || !(*i)->get_property (X_("name"), name)) {
+			continue;
+		}
+
+		DataType type = DataType::AUDIO;
+		(*i)->get_property (X_("type"), type);
+
+		/* SMF are parsed completely, audio files only need their header */
+		bool const whole_file = (type == DataType::MIDI);
+
+		if (Glib::path_is_absolute (name)) {
+			_entries.push_back (Entry (name, whole_file));
+			continue;
+		}
+
+		/* the file is looked up in all directories of the search path */
+		std::vector<std::string> const& dirs (type == DataType::MIDI ? midi_dirs : audio_dirs);
+		for (std::vector<std::string>::const_iterator d = dirs.begin (); d != dirs.end (); ++d) {
+			_entries.push_back (Entry (Glib::build_filename (*d, name), whole_file));
+		}
+	}
+
+	n_threads = std::min<int32_t> (n_threads, _entries.size () / 2);
+
+	for (int32_t n = 0; n < n_threads; ++n) {
+		pthread_t thread_id;
+		if (pthread_create_and_store ("session load", &thread_id, _thread, this)) {
+			break;
+		}
+		_threads.push_back (thread_id);
+	}
+}
+
+SourceFilePrefetcher::~SourceFilePrefetcher ()
+{
+	/* skip remaining files */
+	g_atomic_int_set (&_next, _entries.size ());
+
+	for (std::vector<pthread_t>::const_iterator i = _threads.begin (); i != _threads.end (); ++i) {
+		pthread_join (*i, NULL);
+	}
+}
+
+void*
+SourceFilePrefetcher::_thread (void* arg)
+{
+	pthread_set_name (X_("session load"));
+	static_cast<SourceFilePrefetcher*> (arg)->thread ();
+	return 0;
+}
+
+void
+SourceFilePrefetcher::thread ()
+{
+	const size_t              bufsize = 65536;
+	boost::scoped_array<char> buf (new char[bufsize]);
+
+	const gint n_entries = _entries.size ();
+
+	while (true) {
+		gint n = g_atomic_int_add (&_next, 1);
+		if (n >= n_entries) {
+			break;
+		}
+		read_file (_entries[n], buf.get (), bufsize);
+	}
+}
+
+void
+SourceFilePrefetcher::read_file (Entry const& e, char* buf, size_t bufsize) const
+{
+	int fd = g_open (e.path.c_str (), O_RDONLY, 0444);
+
+	if (fd < 0) {
+		/* most likely not in this directory of the search path */
+		return;
+	}
+
+	while (::read (fd, buf, bufsize) == (ssize_t) bufsize) {
+		if (!e.whole_file) {
+			break;
+		}
+	}
+
+	::close (fd);
+}
+
+}
+
 int
 Session::load_sources (const XMLNode& node)
 {
@@ -2383,6 +2517,14 @@ Session::load_sources (const XMLNode& node)
 
 	nlist = node.children();
 
+	int32_t n_threads = Config->get_session_load_threads ();
+	if (n_threads < 0) {
+		/* this is bound by file-system latency, not CPU */
+		n_threads = std::min<int32_t> (8, 2 * hardware_concurrency ());
+	}
+
+	SourceFilePrefetcher prefetcher (*this, nlist, n_threads);
+
 	set_dirty();
 	std::map<std::string, std::string> relocation;
 
@@ -41,6 +41,8 @@
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
 
+#include "ardour/mapped_audio_file.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/sndfilesource.h"
 #include "ardour/sndfile_helpers.h"
@@ -65,6 +67,8 @@ SndFileSource::SndFileSource (Session& s, const XMLNode& node)
 	, AudioFileSource (s, node)
 	, _sndfile (0)
 	, _broadcast_info (0)
+	, _mapped (0)
+	, _mapped_reads (false)
 {
 	init_sndfile ();
 
@@ -85,6 +89,8 @@ SndFileSource::SndFileSource (Session& s, const string& path, int chn, Flag flag
 	, AudioFileSource (s, path, Flag (flags & ~(Writable|Removable|RemovableIfEmpty|RemoveAtDestroy)))
 	, _sndfile (0)
 	, _broadcast_info (0)
+	, _mapped (0)
+	, _mapped_reads (false)
 {
 	_channel = chn;
 
@@ -107,6 +113,8 @@ SndFileSource::SndFileSource (Session& s, const string& path, const string& orig
 	, AudioFileSource (s, path, origin, flags, sfmt, hf)
 	, _sndfile (0)
 	, _broadcast_info (0)
+	, _mapped (0)
+	, _mapped_reads (false)
 {
 	int fmt = 0;
 
@@ -208,6 +216,8 @@ SndFileSource::SndFileSource (Session& s, const string& path, int chn)
 	, AudioFileSource (s, path, Flag (0))
 	, _sndfile (0)
 	, _broadcast_info (0)
+	, _mapped (0)
+	, _mapped_reads (false)
 {
 	_channel = chn;
 
@@ -227,6 +237,8 @@ SndFileSource::SndFileSource (Session& s, const AudioFileSource& other, const st
 	, AudioFileSource (s, path, "", Flag ((other.flags () | default_writable_flags | NoPeakFile) & ~RF64_RIFF), /*unused*/ FormatFloat, /*unused*/ WAVE64)
 	, _sndfile (0)
 	, _broadcast_info (0)
+	, _mapped (0)
+	, _mapped_reads (false)
 {
 	if (other.readable_length () == 0) {
 		throw failed_constructor();
@@ -329,6 +341,10 @@ SndFileSource::init_sndfile ()
 void
 SndFileSource::close ()
 {
+	delete _mapped;
+	_mapped = 0;
+	_mapped_reads = false;
+
 	if (_sndfile) {
 		sf_close (_sndfile);
 		_sndfile = 0;
@@ -449,7 +465,18 @@ SndFileSource::open ()
                                 _broadcast_info = 0;
                         }
                 }
-        }
+        } else if (Config->get_mmap_audio_files () || Config->get_disk_read_ahead_hints ()) {
+		/* read uncompressed data directly from the page-cache, the map
+		 * also locates the sample data for read-ahead hints.
+		 */
+		assert (!_mapped);
+		_mapped = MappedAudioFile::open (_path);
+		if (_mapped && (_mapped->channels () != (uint32_t) _info.channels || _mapped->length () != _length)) {
+			delete _mapped;
+			_mapped = 0;
+		}
+		_mapped_reads = _mapped && Config->get_mmap_audio_files ();
+	}
 
 	return 0;
 }
@@ -466,6 +493,16 @@ SndFileSource::sample_rate () const
 	return _info.samplerate;
 }
 
+void
+SndFileSource::prefetch (samplepos_t start, samplecnt_t cnt) const
+{
+	/* only files that can be mapped have known sample data offsets */
+	Glib::Threads::Mutex::Lock lm (_lock);
+	if (_mapped) {
+		_mapped->prefetch (start, cnt);
+	}
+}
+
 samplecnt_t
 SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) const
 {
@@ -487,6 +524,14 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 		return 0;
         }
 
+	if (_mapped_reads) {
+		samplecnt_t nread = _mapped->read (dst, start, cnt, _channel, _gain);
+		if (nread != cnt) {
+			memset (dst + nread, 0, sizeof (Sample) * (cnt - nread));
+		}
+		return nread;
+	}
+
 	if (start > _length) {
 
 		/* read starts beyond end of data, just memset to zero */
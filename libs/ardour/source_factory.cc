@@ -26,6 +26,7 @@
 
 #include "pbd/error.h"
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
 #include "pbd/pthread_utils.h"
 #include "pbd/stacktrace.h"
 
@@ -41,6 +42,7 @@
 #include "ardour/silentfilesource.h"
 #include "ardour/smf_source.h"
 #include "ardour/session.h"
+#include "ardour/rc_configuration.h"
 
 #ifdef HAVE_COREAUDIO
 #include "ardour/coreaudiosource.h"
@@ -56,6 +58,7 @@ PBD::Signal1<void,boost::shared_ptr<Source> > SourceFactory::SourceCreated;
 Glib::Threads::Cond SourceFactory::PeaksToBuild;
 Glib::Threads::Mutex SourceFactory::peak_building_lock;
 std::list<boost::weak_ptr<AudioSource> > SourceFactory::files_with_peaks;
+std::list<boost::weak_ptr<AudioSource const> > SourceFactory::files_with_peak_levels;
 
 static int active_threads = 0;
 
@@ -70,12 +73,24 @@ peak_thread_work ()
 		SourceFactory::peak_building_lock.lock ();
 
 	  wait:
-		if (SourceFactory::files_with_peaks.empty()) {
+		if (SourceFactory::files_with_peaks.empty() && SourceFactory::files_with_peak_levels.empty()) {
 			SourceFactory::PeaksToBuild.wait (SourceFactory::peak_building_lock);
 		}
 
 		if (SourceFactory::files_with_peaks.empty()) {
-			goto wait;
+			if (SourceFactory::files_with_peak_levels.empty()) {
+				goto wait;
+			}
+
+			/* peakfiles take precedence, levels only speed up display */
+			boost::shared_ptr<AudioSource const> as (SourceFactory::files_with_peak_levels.front().lock());
+			SourceFactory::files_with_peak_levels.pop_front ();
+			SourceFactory::peak_building_lock.unlock ();
+
+			if (as) {
+				as->build_peak_levels ();
+			}
+			continue;
 		}
 
 		boost::shared_ptr<AudioSource> as (SourceFactory::files_with_peaks.front().lock());
@@ -105,7 +120,14 @@ SourceFactory::peak_work_queue_length ()
 void
 SourceFactory::init ()
 {
-	for (int n = 0; n < 2; ++n) {
+	int32_t n_threads = Config->get_peak_build_threads ();
+
+	if (n_threads < 0) {
+		/* peak-building is mostly limited by disk I/O */
+		n_threads = std::max<int32_t> (2, std::min<int32_t> (8, hardware_concurrency ()));
+	}
+
+	for (int32_t n = 0; n < std::max<int32_t> (1, n_threads); ++n) {
 		Glib::Threads::Thread::create (sigc::ptr_fun (::peak_thread_work));
 	}
 }
@@ -121,7 +143,12 @@ SourceFactory::setup_peakfile (boost::shared_ptr<Source> s, bool async)
 		if (async && !as->empty() && !(as->flags() & Source::NoPeakFile)) {
 
 			Glib::Threads::Mutex::Lock lm (peak_building_lock);
-			files_with_peaks.push_back (boost::weak_ptr<AudioSource> (as));
+			if (as->session ().loading ()) {
+				files_with_peaks.push_back (boost::weak_ptr<AudioSource> (as));
+			} else {
+				/* newly added sources are likely to be displayed next */
+				files_with_peaks.push_front (boost::weak_ptr<AudioSource> (as));
+			}
 			PeaksToBuild.broadcast ();
 
 		} else {
@@ -136,6 +163,34 @@ SourceFactory::setup_peakfile (boost::shared_ptr<Source> s, bool async)
 	return 0;
 }
 
+void
+SourceFactory::prioritize_peakfile (boost::shared_ptr<Source> s)
+{
+	boost::shared_ptr<AudioSource> as (boost::dynamic_pointer_cast<AudioSource> (s));
+
+	if (!as) {
+		return;
+	}
+
+	boost::weak_ptr<AudioSource> wp (as);
+	Glib::Threads::Mutex::Lock lm (peak_building_lock);
+
+	for (std::list<boost::weak_ptr<AudioSource> >::iterator i = files_with_peaks.begin (); i != files_with_peaks.end (); ++i) {
+		if (!i->owner_before (wp) && !wp.owner_before (*i)) {
+			files_with_peaks.splice (files_with_peaks.begin (), files_with_peaks, i);
+			break;
+		}
+	}
+}
+
+void
+SourceFactory::build_peak_levels (boost::shared_ptr<AudioSource const> as)
+{
+	Glib::Threads::Mutex::Lock lm (peak_building_lock);
+	files_with_peak_levels.push_back (boost::weak_ptr<AudioSource const> (as));
+	PeaksToBuild.signal ();
+}
+
 boost::shared_ptr<Source>
 SourceFactory::createSilent (Session& s, const XMLNode& node, samplecnt_t nframes, float sr)
 {
@@ -374,6 +374,184 @@ x86_sse_avx_copy_vector(float *dst, const float *src, uint32_t nframes)
 	(void) memcpy(dst, src, nframes * sizeof(float));
 }
 
+/**
+ * @brief Load 4 consecutive samples of 8 channels, transposed
+ *
+ * @details After this call s[j] holds sample (i + j) of every channel,
+ * channel n in element n.
+ */
+static inline void
+avx_load_8x4(const float *const *src, uint32_t i, __m256 s[4])
+{
+	__m128 l0 = _mm_loadu_ps(src[0] + i);
+	__m128 l1 = _mm_loadu_ps(src[1] + i);
+	__m128 l2 = _mm_loadu_ps(src[2] + i);
+	__m128 l3 = _mm_loadu_ps(src[3] + i);
+	__m128 h0 = _mm_loadu_ps(src[4] + i);
+	__m128 h1 = _mm_loadu_ps(src[5] + i);
+	__m128 h2 = _mm_loadu_ps(src[6] + i);
+	__m128 h3 = _mm_loadu_ps(src[7] + i);
+	_MM_TRANSPOSE4_PS(l0, l1, l2, l3);
+	_MM_TRANSPOSE4_PS(h0, h1, h2, h3);
+	s[0] = _mm256_insertf128_ps(_mm256_castps128_ps256(l0), h0, 1);
+	s[1] = _mm256_insertf128_ps(_mm256_castps128_ps256(l1), h1, 1);
+	s[2] = _mm256_insertf128_ps(_mm256_castps128_ps256(l2), h2, 1);
+	s[3] = _mm256_insertf128_ps(_mm256_castps128_ps256(l3), h3, 1);
+}
+
+/**
+ * @brief x86-64 AVX K-meter ballistics, 8 channels in parallel
+ *
+ * Remaining channels are processed with the SSE variant.
+ *
+ * @param src Array of n_chn source buffers
+ * @param n_chn Number of channels
+ * @param nframes Number of frames to process (multiple of 4)
+ * @param omega Filter coefficient
+ * @param[in,out] z1 Per channel filter state
+ * @param[in,out] z2 Per channel filter state
+ */
+C_FUNC void
+x86_sse_avx_kmeter_process(const float *const *src, uint32_t n_chn, uint32_t nframes, float omega, float *z1, float *z2)
+{
+	const __m256 w  = _mm256_set1_ps(omega);
+	const __m256 w4 = _mm256_set1_ps(4 * omega);
+
+	uint32_t c = 0;
+	for (; c + 8 <= n_chn; c += 8) {
+		__m256 a = _mm256_loadu_ps(z1 + c);
+		__m256 b = _mm256_loadu_ps(z2 + c);
+		__m256 s[4];
+
+		for (uint32_t i = 0; i + 4 <= nframes; i += 4) {
+			avx_load_8x4(src + c, i, s);
+			for (int j = 0; j < 4; ++j) {
+				a = _mm256_add_ps(a, _mm256_mul_ps(w, _mm256_sub_ps(_mm256_mul_ps(s[j], s[j]), a)));
+			}
+			b = _mm256_add_ps(b, _mm256_mul_ps(w4, _mm256_sub_ps(a, b)));
+		}
+
+		_mm256_storeu_ps(z1 + c, a);
+		_mm256_storeu_ps(z2 + c, b);
+	}
+
+	// zero upper 128 bit of 256 bit ymm register to avoid penalties using non-AVX instructions
+	_mm256_zeroupper();
+
+	if (c < n_chn) {
+		x86_sse_kmeter_process(src + c, n_chn - c, nframes, omega, z1 + c, z2 + c);
+	}
+}
+
+/**
+ * @brief x86-64 AVX IEC type I/II PPM ballistics, 8 channels in parallel
+ *
+ * Remaining channels are processed with the SSE variant.
+ *
+ * @param src Array of n_chn source buffers
+ * @param n_chn Number of channels
+ * @param nframes Number of frames to process (multiple of 4)
+ * @param w1 Attack coefficient of the first filter
+ * @param w2 Attack coefficient of the second filter
+ * @param w3 Release coefficient
+ * @param[in,out] z1 Per channel filter state
+ * @param[in,out] z2 Per channel filter state
+ * @param[in,out] m Per channel peak value
+ */
+C_FUNC void
+x86_sse_avx_ppm_process(const float *const *src, uint32_t n_chn, uint32_t nframes, float w1, float w2, float w3, float *z1, float *z2, float *m)
+{
+	const __m256 ABS_MASK = _mm256_set1_ps(-0.0F);
+	const __m256 ZERO     = _mm256_setzero_ps();
+	const __m256 vw1      = _mm256_set1_ps(w1);
+	const __m256 vw2      = _mm256_set1_ps(w2);
+	const __m256 vw3      = _mm256_set1_ps(w3);
+
+	uint32_t c = 0;
+	for (; c + 8 <= n_chn; c += 8) {
+		__m256 a  = _mm256_loadu_ps(z1 + c);
+		__m256 b  = _mm256_loadu_ps(z2 + c);
+		__m256 pk = _mm256_loadu_ps(m + c);
+		__m256 s[4];
+
+		for (uint32_t i = 0; i + 4 <= nframes; i += 4) {
+			avx_load_8x4(src + c, i, s);
+			a = _mm256_mul_ps(a, vw3);
+			b = _mm256_mul_ps(b, vw3);
+			for (int j = 0; j < 4; ++j) {
+				// if (t > z) z += w * (t - z)
+				const __m256 t = _mm256_andnot_ps(ABS_MASK, s[j]);
+				a = _mm256_add_ps(a, _mm256_mul_ps(vw1, _mm256_max_ps(_mm256_sub_ps(t, a), ZERO)));
+				b = _mm256_add_ps(b, _mm256_mul_ps(vw2, _mm256_max_ps(_mm256_sub_ps(t, b), ZERO)));
+			}
+			pk = _mm256_max_ps(_mm256_add_ps(a, b), pk);
+		}
+
+		_mm256_storeu_ps(z1 + c, a);
+		_mm256_storeu_ps(z2 + c, b);
+		_mm256_storeu_ps(m + c, pk);
+	}
+
+	// zero upper 128 bit of 256 bit ymm register to avoid penalties using non-AVX instructions
+	_mm256_zeroupper();
+
+	if (c < n_chn) {
+		x86_sse_ppm_process(src + c, n_chn - c, nframes, w1, w2, w3, z1 + c, z2 + c, m + c);
+	}
+}
+
+/**
+ * @brief x86-64 AVX VU-meter ballistics, 8 channels in parallel
+ *
+ * Remaining channels are processed with the SSE variant.
+ *
+ * @param src Array of n_chn source buffers
+ * @param n_chn Number of channels
+ * @param nframes Number of frames to process (multiple of 4)
+ * @param w Filter coefficient
+ * @param[in,out] z1 Per channel filter state
+ * @param[in,out] z2 Per channel filter state
+ * @param[in,out] m Per channel peak value
+ */
+C_FUNC void
+x86_sse_avx_vumeter_process(const float *const *src, uint32_t n_chn, uint32_t nframes, float w, float *z1, float *z2, float *m)
+{
+	const __m256 ABS_MASK = _mm256_set1_ps(-0.0F);
+	const __m256 HALF     = _mm256_set1_ps(0.5F);
+	const __m256 vw       = _mm256_set1_ps(w);
+	const __m256 vw4      = _mm256_set1_ps(4 * w);
+
+	uint32_t c = 0;
+	for (; c + 8 <= n_chn; c += 8) {
+		__m256 a  = _mm256_loadu_ps(z1 + c);
+		__m256 b  = _mm256_loadu_ps(z2 + c);
+		__m256 pk = _mm256_loadu_ps(m + c);
+		__m256 s[4];
+
+		for (uint32_t i = 0; i + 4 <= nframes; i += 4) {
+			avx_load_8x4(src + c, i, s);
+			const __m256 t2 = _mm256_mul_ps(b, HALF);
+			for (int j = 0; j < 4; ++j) {
+				const __m256 t1 = _mm256_sub_ps(_mm256_andnot_ps(ABS_MASK, s[j]), t2);
+				a = _mm256_add_ps(a, _mm256_mul_ps(vw, _mm256_sub_ps(t1, a)));
+			}
+			b  = _mm256_add_ps(b, _mm256_mul_ps(vw4, _mm256_sub_ps(a, b)));
+			pk = _mm256_max_ps(b, pk);
+		}
+
+		_mm256_storeu_ps(z1 + c, a);
+		_mm256_storeu_ps(z2 + c, b);
+		_mm256_storeu_ps(m + c, pk);
+	}
+
+	// zero upper 128 bit of 256 bit ymm register to avoid penalties using non-AVX instructions
+	_mm256_zeroupper();
+
+	if (c < n_chn) {
+		x86_sse_vumeter_process(src + c, n_chn - c, nframes, w, z1 + c, z2 + c, m + c);
+	}
+}
+
 /**
  * Local helper functions
  */
@@ -18,6 +18,7 @@
  */
 
 #include <xmmintrin.h>
+#include "ardour/mix.h"
 #include "ardour/types.h"
 
 void
@@ -114,5 +115,126 @@ x86_sse_find_peaks(const ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float *
 	_mm_store_ss(max, work);
 }
 
+/* Multi-channel meter ballistics, 4 channels are processed in parallel,
+ * one per SIMD lane. Results are identical to the default_* variants.
+ */
+
+/* load 4 consecutive samples of 4 channels, one sample of every channel per vector */
+static inline void
+load_4x4 (float const* const* src, uint32_t i, __m128& s0, __m128& s1, __m128& s2, __m128& s3)
+{
+	s0 = _mm_loadu_ps (src[0] + i);
+	s1 = _mm_loadu_ps (src[1] + i);
+	s2 = _mm_loadu_ps (src[2] + i);
+	s3 = _mm_loadu_ps (src[3] + i);
+	_MM_TRANSPOSE4_PS (s0, s1, s2, s3);
+}
+
+static inline __m128
+abs_ps (__m128 x)
+{
+	return _mm_andnot_ps (_mm_set1_ps (-0.f), x);
+}
+
+void
+x86_sse_kmeter_process (float const* const* src, uint32_t n_chn, uint32_t nframes, float omega, float* z1, float* z2)
+{
+	const __m128 w  = _mm_set1_ps (omega);
+	const __m128 w4 = _mm_set1_ps (4 * omega);
+
+	uint32_t c = 0;
+	for (; c + 4 <= n_chn; c += 4) {
+		__m128 a = _mm_loadu_ps (z1 + c);
+		__m128 b = _mm_loadu_ps (z2 + c);
+		__m128 s0, s1, s2, s3;
+
+		for (uint32_t i = 0; i + 4 <= nframes; i += 4) {
+			load_4x4 (src + c, i, s0, s1, s2, s3);
+			a = _mm_add_ps (a, _mm_mul_ps (w, _mm_sub_ps (_mm_mul_ps (s0, s0), a)));
+			a = _mm_add_ps (a, _mm_mul_ps (w, _mm_sub_ps (_mm_mul_ps (s1, s1), a)));
+			a = _mm_add_ps (a, _mm_mul_ps (w, _mm_sub_ps (_mm_mul_ps (s2, s2), a)));
+			a = _mm_add_ps (a, _mm_mul_ps (w, _mm_sub_ps (_mm_mul_ps (s3, s3), a)));
+			b = _mm_add_ps (b, _mm_mul_ps (w4, _mm_sub_ps (a, b)));
+		}
+
+		_mm_storeu_ps (z1 + c, a);
+		_mm_storeu_ps (z2 + c, b);
+	}
+
+	if (c < n_chn) {
+		default_kmeter_process (src + c, n_chn - c, nframes, omega, z1 + c, z2 + c);
+	}
+}
 
+void
+x86_sse_ppm_process (float const* const* src, uint32_t n_chn, uint32_t nframes, float w1, float w2, float w3, float* z1, float* z2, float* m)
+{
+	const __m128 vw1  = _mm_set1_ps (w1);
+	const __m128 vw2  = _mm_set1_ps (w2);
+	const __m128 vw3  = _mm_set1_ps (w3);
+	const __m128 zero = _mm_setzero_ps ();
+
+	uint32_t c = 0;
+	for (; c + 4 <= n_chn; c += 4) {
+		__m128 a  = _mm_loadu_ps (z1 + c);
+		__m128 b  = _mm_loadu_ps (z2 + c);
+		__m128 pk = _mm_loadu_ps (m + c);
+		__m128 s[4];
+
+		for (uint32_t i = 0; i + 4 <= nframes; i += 4) {
+			load_4x4 (src + c, i, s[0], s[1], s[2], s[3]);
+			a = _mm_mul_ps (a, vw3);
+			b = _mm_mul_ps (b, vw3);
+			for (int j = 0; j < 4; ++j) {
+				/* if (t > z) z += w * (t - z) */
+				const __m128 t = abs_ps (s[j]);
+				a = _mm_add_ps (a, _mm_mul_ps (vw1, _mm_max_ps (_mm_sub_ps (t, a), zero)));
+				b = _mm_add_ps (b, _mm_mul_ps (vw2, _mm_max_ps (_mm_sub_ps (t, b), zero)));
+			}
+			pk = _mm_max_ps (_mm_add_ps (a, b), pk);
+		}
+
+		_mm_storeu_ps (z1 + c, a);
+		_mm_storeu_ps (z2 + c, b);
+		_mm_storeu_ps (m + c, pk);
+	}
+
+	if (c < n_chn) {
+		default_ppm_process (src + c, n_chn - c, nframes, w1, w2, w3, z1 + c, z2 + c, m + c);
+	}
+}
 
+void
+x86_sse_vumeter_process (float const* const* src, uint32_t n_chn, uint32_t nframes, float w, float* z1, float* z2, float* m)
+{
+	const __m128 vw   = _mm_set1_ps (w);
+	const __m128 vw4  = _mm_set1_ps (4 * w);
+	const __m128 half = _mm_set1_ps (.5f);
+
+	uint32_t c = 0;
+	for (; c + 4 <= n_chn; c += 4) {
+		__m128 a  = _mm_loadu_ps (z1 + c);
+		__m128 b  = _mm_loadu_ps (z2 + c);
+		__m128 pk = _mm_loadu_ps (m + c);
+		__m128 s[4];
+
+		for (uint32_t i = 0; i + 4 <= nframes; i += 4) {
+			load_4x4 (src + c, i, s[0], s[1], s[2], s[3]);
+			const __m128 t2 = _mm_mul_ps (b, half);
+			for (int j = 0; j < 4; ++j) {
+				const __m128 t1 = _mm_sub_ps (abs_ps (s[j]), t2);
+				a = _mm_add_ps (a, _mm_mul_ps (vw, _mm_sub_ps (t1, a)));
+			}
+			b  = _mm_add_ps (b, _mm_mul_ps (vw4, _mm_sub_ps (a, b)));
+			pk = _mm_max_ps (b, pk);
+		}
+
+		_mm_storeu_ps (z1 + c, a);
+		_mm_storeu_ps (z2 + c, b);
+		_mm_storeu_ps (m + c, pk);
+	}
+
+	if (c < n_chn) {
+		default_vumeter_process (src + c, n_chn - c, nframes, w, z1 + c, z2 + c, m + c);
+	}
+}
@@ -25,6 +25,7 @@
  */
 
 #include <algorithm>
+#include <limits>
 #include <stdexcept>
 #include <cmath>
 
@@ -740,6 +741,7 @@ TempoMap::TempoMap (samplecnt_t fr)
 	_metrics.push_back (t);
 	_metrics.push_back (m);
 
+	rebuild_index ();
 }
 
 TempoMap&
@@ -747,7 +749,7 @@ TempoMap::operator= (TempoMap const & other)
 {
 	if (&other != this) {
 		Glib::Threads::RWLock::ReaderLock lr (other.lock);
-		Glib::Threads::RWLock::WriterLock lm (lock);
+		MapWriterLock lm (*this);
 		_sample_rate = other._sample_rate;
 
 		Metrics::const_iterator d = _metrics.begin();
@@ -804,7 +806,7 @@ TempoMap::remove_tempo (const TempoSection& tempo, bool complete_operation)
 	bool removed = false;
 
 	{
-		Glib::Threads::RWLock::WriterLock lm (lock);
+		MapWriterLock lm (*this);
 		if ((removed = remove_tempo_locked (tempo))) {
 			if (complete_operation) {
 				recompute_map (_metrics);
@@ -843,7 +845,7 @@ TempoMap::remove_meter (const MeterSection& tempo, bool complete_operation)
 	bool removed = false;
 
 	{
-		Glib::Threads::RWLock::WriterLock lm (lock);
+		MapWriterLock lm (*this);
 		if ((removed = remove_meter_locked (tempo))) {
 			if (complete_operation) {
 				recompute_map (_metrics);
@@ -1036,7 +1038,7 @@ TempoMap::add_tempo (const Tempo& tempo, const double& pulse, const samplepos_t
 
 	TempoSection* ts = 0;
 	{
-		Glib::Threads::RWLock::WriterLock lm (lock);
+		MapWriterLock lm (*this);
 		/* here we default to not clamped for a new tempo section. preference? */
 		ts = add_tempo_locked (tempo, pulse, minute_at_sample (sample), pls, true, false, false);
 
@@ -1061,7 +1063,7 @@ TempoMap::replace_tempo (TempoSection& ts, const Tempo& tempo, const double& pul
 	TempoSection* new_ts = 0;
 
 	{
-		Glib::Threads::RWLock::WriterLock lm (lock);
+		MapWriterLock lm (*this);
 		TempoSection& first (first_tempo());
 		if (!ts.initial()) {
 			if (locked_to_meter) {
@@ -1138,7 +1140,7 @@ TempoMap::add_meter (const Meter& meter, const Timecode::BBT_Time& where, sample
 {
 	MeterSection* m = 0;
 	{
-		Glib::Threads::RWLock::WriterLock lm (lock);
+		MapWriterLock lm (*this);
 		m = add_meter_locked (meter, where, sample, pls, true);
 	}
 
@@ -1157,7 +1159,7 @@ void
 TempoMap::replace_meter (const MeterSection& ms, const Meter& meter, const BBT_Time& where, samplepos_t sample, PositionLockStyle pls)
 {
 	{
-		Glib::Threads::RWLock::WriterLock lm (lock);
+		MapWriterLock lm (*this);
 
 		if (!ms.initial()) {
 			remove_meter_locked (ms);
@@ -1253,7 +1255,7 @@ TempoMap::change_initial_tempo (double note_types_per_minute, double note_type,
 				continue;
 			}
 			{
-				Glib::Threads::RWLock::WriterLock lm (lock);
+				MapWriterLock lm (*this);
 				*((Tempo*) t) = newtempo;
 				recompute_map (_metrics);
 			}
@@ -1306,7 +1308,7 @@ TempoMap::change_existing_tempo_at (samplepos_t where, double note_types_per_min
 	/* reset */
 
 	{
-		Glib::Threads::RWLock::WriterLock lm (lock);
+		MapWriterLock lm (*this);
 		/* cannot move the first tempo section */
 		*((Tempo*)prev) = newtempo;
 		recompute_map (_metrics);
@@ -1532,6 +1534,128 @@ TempoMap::recompute_map (Metrics& metrics, samplepos_t end)
 	recompute_meters (metrics);
 }
 
+void
+TempoMap::MetricIndex::clear ()
+{
+	valid = false;
+
+	sections.clear ();
+	samples.clear ();
+	tempo_before.clear ();
+	meter_before.clear ();
+	tempi.clear ();
+	tempo_minutes.clear ();
+	tempo_pulses.clear ();
+	meters.clear ();
+	meter_minutes.clear ();
+	meter_beats.clear ();
+	meter_pulses.clear ();
+	meter_bars.clear ();
+}
+
+static bool
+keys_sorted (std::vector<double> const& keys)
+{
+	for (size_t n = 1; n < keys.size (); ++n) {
+		if (keys[n] < keys[n - 1]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/** Index of the section that the linear scans over the list select:
+ * the last one with a key not greater than @param val, or the first one.
+ * Keys must be sorted.
+ */
+static inline size_t
+index_at (std::vector<double> const& keys, double val)
+{
+	const size_t n = std::upper_bound (keys.begin(), keys.end(), val) - keys.begin();
+	return n > 0 ? n - 1 : 0;
+}
+
+/* the beat of a tempo section's pulse, relative to a given meter (see minute_at_beat_locked) */
+struct BeatAtPulse {
+	BeatAtPulse (const MeterSection& m) : meter (m) {}
+
+	bool operator() (double beat, double pulse) const {
+		return ((pulse - meter.pulse()) * meter.note_divisor()) + meter.beat() > beat;
+	}
+
+	const MeterSection& meter;
+};
+
+static inline size_t
+tempo_index_at_beat (std::vector<double> const& pulses, const MeterSection& prev_m, double beat)
+{
+	const size_t n = std::upper_bound (pulses.begin(), pulses.end(), beat, BeatAtPulse (prev_m)) - pulses.begin();
+	return n > 0 ? n - 1 : 0;
+}
+
+void
+TempoMap::rebuild_index ()
+{
+	/* CALLER MUST HOLD WRITE LOCK */
+
+	_index.clear ();
+
+	const TempoSection* prev_t = 0;
+	const MeterSection* prev_m = 0;
+	samplepos_t         prev_sample = 0;
+	bool                sorted = true;
+
+	for (Metrics::const_iterator i = _metrics.begin(); i != _metrics.end(); ++i) {
+		const samplepos_t sample = (*i)->sample();
+
+		if (i != _metrics.begin() && sample < prev_sample) {
+			sorted = false;
+		}
+		prev_sample = sample;
+
+		if ((*i)->is_tempo()) {
+			TempoSection* t = static_cast<TempoSection*> (*i);
+			prev_t = t;
+			if (t->active()) {
+				_index.tempi.push_back (t);
+				_index.tempo_minutes.push_back (t->minute());
+				_index.tempo_pulses.push_back (t->pulse());
+			}
+		} else {
+			MeterSection* m = static_cast<MeterSection*> (*i);
+			if (prev_m) {
+				/* this is the comparison used by beat_at_bbt_locked () */
+				const double bars_to_m = (m->beat() - prev_m->beat()) / prev_m->divisions_per_bar();
+				_index.meter_bars.push_back (bars_to_m + (prev_m->bbt().bars - 1));
+			} else {
+				/* the first meter is always used */
+				_index.meter_bars.push_back (-std::numeric_limits<double>::infinity());
+			}
+			prev_m = m;
+			_index.meters.push_back (m);
+			_index.meter_minutes.push_back (m->minute());
+			_index.meter_beats.push_back (m->beat());
+			_index.meter_pulses.push_back (m->pulse());
+		}
+
+		_index.sections.push_back (*i);
+		_index.samples.push_back (sample);
+		_index.tempo_before.push_back (prev_t);
+		_index.meter_before.push_back (prev_m);
+	}
+
+	/* binary searches only agree with the linear scans if the sections are
+	 * in order. This is always the case for a solved map, but not necessarily
+	 * while a map is being loaded or changed; in which case lookups fall back
+	 * to walking the list.
+	 */
+	_index.valid = sorted
+		&& !_index.tempi.empty () && !_index.meters.empty ()
+		&& keys_sorted (_index.tempo_minutes) && keys_sorted (_index.tempo_pulses)
+		&& keys_sorted (_index.meter_minutes) && keys_sorted (_index.meter_beats)
+		&& keys_sorted (_index.meter_pulses) && keys_sorted (_index.meter_bars);
+}
+
 TempoMetric
 TempoMap::metric_at (samplepos_t sample, Metrics::const_iterator* last) const
 {
@@ -1549,6 +1673,23 @@ TempoMap::metric_at (samplepos_t sample, Metrics::const_iterator* last) const
 	   now see if we can find better candidates.
 	*/
 
+	if (!last && _index.valid) {
+		const size_t n = std::upper_bound (_index.samples.begin(), _index.samples.end(), sample) - _index.samples.begin();
+
+		if (n > 0) {
+			if (_index.tempo_before[n - 1]) {
+				m.set_tempo (*_index.tempo_before[n - 1]);
+			}
+			if (_index.meter_before[n - 1]) {
+				m.set_meter (*_index.meter_before[n - 1]);
+			}
+			m.set_minute (_index.sections[n - 1]->minute());
+			m.set_pulse (_index.sections[n - 1]->pulse());
+		}
+
+		return m;
+	}
+
 	for (Metrics::const_iterator i = _metrics.begin(); i != _metrics.end(); ++i) {
 
 		if ((*i)->sample() > sample) {
@@ -1621,13 +1762,21 @@ TempoMap::beat_at_minute_locked (const Metrics& metrics, const double& minute) c
 	MeterSection* prev_m = 0;
 	MeterSection* next_m = 0;
 
-	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
-		if (!(*i)->is_tempo()) {
-			if (prev_m && (*i)->minute() > minute) {
-				next_m = static_cast<MeterSection*> (*i);
-				break;
+	if (use_index (metrics)) {
+		const size_t n = index_at (_index.meter_minutes, minute);
+		prev_m = _index.meters[n];
+		if (n + 1 < _index.meters.size()) {
+			next_m = _index.meters[n + 1];
+		}
+	} else {
+		for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
+			if (!(*i)->is_tempo()) {
+				if (prev_m && (*i)->minute() > minute) {
+					next_m = static_cast<MeterSection*> (*i);
+					break;
+				}
+				prev_m = static_cast<MeterSection*> (*i);
 			}
-			prev_m = static_cast<MeterSection*> (*i);
 		}
 	}
 
@@ -1664,6 +1813,13 @@ TempoMap::minute_at_beat_locked (const Metrics& metrics, const double& beat) con
 	MeterSection* prev_m = 0;
 	TempoSection* prev_t = 0;
 
+	if (use_index (metrics)) {
+		prev_m = _index.meters[index_at (_index.meter_beats, beat)];
+		prev_t = _index.tempi[tempo_index_at_beat (_index.tempo_pulses, *prev_m, beat)];
+
+		return prev_t->minute_at_pulse (((beat - prev_m->beat()) / prev_m->note_divisor()) + prev_m->pulse());
+	}
+
 	MeterSection* m;
 
 	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
@@ -1717,6 +1873,15 @@ TempoMap::tempo_at_minute_locked (const Metrics& metrics, const double& minute)
 {
 	TempoSection* prev_t = 0;
 
+	if (use_index (metrics)) {
+		const size_t n = index_at (_index.tempo_minutes, minute);
+		prev_t = _index.tempi[n];
+		if (n + 1 < _index.tempi.size()) {
+			return prev_t->tempo_at_minute (minute);
+		}
+		return Tempo (prev_t->note_types_per_minute(), prev_t->note_type(), prev_t->end_note_types_per_minute());
+	}
+
 	TempoSection* t;
 
 	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
@@ -1909,14 +2074,18 @@ TempoMap::beat_at_pulse_locked (const Metrics& metrics, const double& pulse) con
 {
 	MeterSection* prev_m = 0;
 
-	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
-		MeterSection* m;
-		if (!(*i)->is_tempo()) {
-			m = static_cast<MeterSection*> (*i);
-			if (prev_m && m->pulse() > pulse) {
-				break;
+	if (use_index (metrics)) {
+		prev_m = _index.meters[index_at (_index.meter_pulses, pulse)];
+	} else {
+		for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
+			MeterSection* m;
+			if (!(*i)->is_tempo()) {
+				m = static_cast<MeterSection*> (*i);
+				if (prev_m && m->pulse() > pulse) {
+					break;
+				}
+				prev_m = m;
 			}
-			prev_m = m;
 		}
 	}
 	assert (prev_m);
@@ -1932,6 +2101,21 @@ TempoMap::pulse_at_minute_locked (const Metrics& metrics, const double& minute)
 	/* HOLD (at least) THE READER LOCK */
 	TempoSection* prev_t = 0;
 
+	if (use_index (metrics)) {
+		const size_t n = index_at (_index.tempo_minutes, minute);
+		prev_t = _index.tempi[n];
+		if (n + 1 < _index.tempi.size()) {
+			const double ret = prev_t->pulse_at_minute (minute);
+			/* audio locked section in new meter*/
+			if (_index.tempo_pulses[n + 1] < ret) {
+				return _index.tempo_pulses[n + 1];
+			}
+			return ret;
+		}
+		const double pulses_in_section = ((minute - prev_t->minute()) * prev_t->note_types_per_minute()) / prev_t->note_type();
+		return pulses_in_section + prev_t->pulse();
+	}
+
 	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
 		TempoSection* t;
 		if ((*i)->is_tempo()) {
@@ -1968,6 +2152,16 @@ TempoMap::minute_at_pulse_locked (const Metrics& metrics, const double& pulse) c
 
 	const TempoSection* prev_t = 0;
 
+	if (use_index (metrics)) {
+		const size_t n = index_at (_index.tempo_pulses, pulse);
+		prev_t = _index.tempi[n];
+		if (n + 1 < _index.tempi.size()) {
+			return prev_t->minute_at_pulse (pulse);
+		}
+		double const dtime = ((pulse - prev_t->pulse()) * prev_t->note_type()) / prev_t->note_types_per_minute();
+		return dtime + prev_t->minute();
+	}
+
 	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
 		TempoSection* t;
 
@@ -2017,16 +2211,20 @@ TempoMap::beat_at_bbt_locked (const Metrics& metrics, const Timecode::BBT_Time&
 	*/
 	MeterSection* m;
 
-	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
-		if (!(*i)->is_tempo()) {
-			m = static_cast<MeterSection*> (*i);
-			if (prev_m) {
-				const double bars_to_m = (m->beat() - prev_m->beat()) / prev_m->divisions_per_bar();
-				if ((bars_to_m + (prev_m->bbt().bars - 1)) > (bbt.bars - 1)) {
-					break;
+	if (use_index (metrics)) {
+		prev_m = _index.meters[index_at (_index.meter_bars, bbt.bars - 1)];
+	} else {
+		for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
+			if (!(*i)->is_tempo()) {
+				m = static_cast<MeterSection*> (*i);
+				if (prev_m) {
+					const double bars_to_m = (m->beat() - prev_m->beat()) / prev_m->divisions_per_bar();
+					if ((bars_to_m + (prev_m->bbt().bars - 1)) > (bbt.bars - 1)) {
+						break;
+					}
 				}
+				prev_m = m;
 			}
-			prev_m = m;
 		}
 	}
 
@@ -2060,17 +2258,21 @@ TempoMap::bbt_at_beat_locked (const Metrics& metrics, const double& b) const
 
 	MeterSection* m = 0;
 
-	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
-		if (!(*i)->is_tempo()) {
-			m = static_cast<MeterSection*> (*i);
-			if (prev_m) {
-				if (m->beat() > beats) {
-					/* this is the meter after the one our beat is on*/
-					break;
+	if (use_index (metrics)) {
+		prev_m = _index.meters[index_at (_index.meter_beats, beats)];
+	} else {
+		for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
+			if (!(*i)->is_tempo()) {
+				m = static_cast<MeterSection*> (*i);
+				if (prev_m) {
+					if (m->beat() > beats) {
+						/* this is the meter after the one our beat is on*/
+						break;
+					}
 				}
-			}
 
-			prev_m = m;
+				prev_m = m;
+			}
 		}
 	}
 	assert (prev_m);
@@ -2301,14 +2503,22 @@ TempoMap::bbt_at_minute_locked (const Metrics& metrics, const double& minute) co
 
 	MeterSection* m;
 
-	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
-		if (!(*i)->is_tempo()) {
-			m = static_cast<MeterSection*> (*i);
-			if (prev_m && m->minute() > minute) {
-				next_m = m;
-				break;
+	if (use_index (metrics)) {
+		const size_t n = index_at (_index.meter_minutes, minute);
+		prev_m = _index.meters[n];
+		if (n + 1 < _index.meters.size()) {
+			next_m = _index.meters[n + 1];
+		}
+	} else {
+		for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
+			if (!(*i)->is_tempo()) {
+				m = static_cast<MeterSection*> (*i);
+				if (prev_m && m->minute() > minute) {
+					next_m = m;
+					break;
+				}
+				prev_m = m;
 			}
-			prev_m = m;
 		}
 	}
 
@@ -3212,7 +3422,7 @@ TempoMap::gui_set_tempo_position (TempoSection* ts, const samplepos_t sample, co
 	if (ts->position_lock_style() == MusicTime) {
 		{
 			/* if we're snapping to a musical grid, set the pulse exactly instead of via the supplied sample. */
-			Glib::Threads::RWLock::WriterLock lm (lock);
+			MapWriterLock lm (*this);
 			TempoSection* tempo_copy = copy_metrics_and_point (_metrics, future_map, ts);
 
 			tempo_copy->set_position_lock_style (AudioTime);
@@ -3231,7 +3441,7 @@ TempoMap::gui_set_tempo_position (TempoSection* ts, const samplepos_t sample, co
 	} else {
 
 		{
-			Glib::Threads::RWLock::WriterLock lm (lock);
+			MapWriterLock lm (*this);
 			TempoSection* tempo_copy = copy_metrics_and_point (_metrics, future_map, ts);
 
 
@@ -3284,7 +3494,7 @@ TempoMap::gui_set_meter_position (MeterSection* ms, const samplepos_t sample)
 	if (ms->position_lock_style() == AudioTime) {
 
 		{
-			Glib::Threads::RWLock::WriterLock lm (lock);
+			MapWriterLock lm (*this);
 			MeterSection* copy = copy_metrics_and_point (_metrics, future_map, ms);
 
 			if (solve_map_minute (future_map, copy, minute_at_sample (sample))) {
@@ -3294,7 +3504,7 @@ TempoMap::gui_set_meter_position (MeterSection* ms, const samplepos_t sample)
 		}
 	} else {
 		{
-			Glib::Threads::RWLock::WriterLock lm (lock);
+			MapWriterLock lm (*this);
 			MeterSection* copy = copy_metrics_and_point (_metrics, future_map, ms);
 
 			const double beat = beat_at_minute_locked (_metrics, minute_at_sample (sample));
@@ -3322,7 +3532,7 @@ TempoMap::gui_change_tempo (TempoSection* ts, const Tempo& bpm)
 	Metrics future_map;
 	bool can_solve = false;
 	{
-		Glib::Threads::RWLock::WriterLock lm (lock);
+		MapWriterLock lm (*this);
 		TempoSection* tempo_copy = copy_metrics_and_point (_metrics, future_map, ts);
 
 		if (tempo_copy->type() == TempoSection::Constant) {
@@ -3389,7 +3599,7 @@ TempoMap::gui_stretch_tempo (TempoSection* ts, const samplepos_t sample, const s
 	Metrics future_map;
 
 	{
-		Glib::Threads::RWLock::WriterLock lm (lock);
+		MapWriterLock lm (*this);
 
 		if (!ts) {
 			return;
@@ -3497,7 +3707,7 @@ TempoMap::gui_stretch_tempo_end (TempoSection* ts, const samplepos_t sample, con
 	Metrics future_map;
 
 	{
-		Glib::Threads::RWLock::WriterLock lm (lock);
+		MapWriterLock lm (*this);
 
 		if (!ts) {
 			return;
@@ -3576,7 +3786,7 @@ TempoMap::gui_twist_tempi (TempoSection* ts, const Tempo& bpm, const samplepos_t
 	samplepos_t const min_dframe = 2;
 
 	{
-		Glib::Threads::RWLock::WriterLock lm (lock);
+		MapWriterLock lm (*this);
 		if (!ts) {
 			return false;
 		}
@@ -4227,6 +4437,10 @@ TempoMap::tempo_section_at_sample (samplepos_t sample)
 const TempoSection&
 TempoMap::tempo_section_at_minute_locked (const Metrics& metrics, double minute) const
 {
+	if (use_index (metrics)) {
+		return *_index.tempi[index_at (_index.tempo_minutes, minute)];
+	}
+
 	TempoSection* prev = 0;
 
 	TempoSection* t;
@@ -4256,6 +4470,10 @@ TempoMap::tempo_section_at_minute_locked (const Metrics& metrics, double minute)
 TempoSection&
 TempoMap::tempo_section_at_minute_locked (const Metrics& metrics, double minute)
 {
+	if (use_index (metrics)) {
+		return *_index.tempi[index_at (_index.tempo_minutes, minute)];
+	}
+
 	TempoSection* prev = 0;
 
 	TempoSection* t;
@@ -4288,6 +4506,10 @@ TempoMap::tempo_section_at_beat_locked (const Metrics& metrics, const double& be
 	TempoSection* prev_t = 0;
 	const MeterSection* prev_m = &meter_section_at_beat_locked (metrics, beat);
 
+	if (use_index (metrics)) {
+		return *_index.tempi[tempo_index_at_beat (_index.tempo_pulses, *prev_m, beat)];
+	}
+
 	TempoSection* t;
 
 	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
@@ -4446,6 +4668,10 @@ TempoMap::meter_section_at_sample (samplepos_t sample) const
 const MeterSection&
 TempoMap::meter_section_at_minute_locked (const Metrics& metrics, double minute) const
 {
+	if (use_index (metrics)) {
+		return *_index.meters[index_at (_index.meter_minutes, minute)];
+	}
+
 	Metrics::const_iterator i;
 	MeterSection* prev = 0;
 
@@ -4475,6 +4701,10 @@ TempoMap::meter_section_at_minute_locked (const Metrics& metrics, double minute)
 const MeterSection&
 TempoMap::meter_section_at_beat_locked (const Metrics& metrics, const double& beat) const
 {
+	if (use_index (metrics)) {
+		return *_index.meters[index_at (_index.meter_beats, beat)];
+	}
+
 	MeterSection* prev_m = 0;
 
 	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
@@ -4635,7 +4865,7 @@ int
 TempoMap::set_state (const XMLNode& node, int /*version*/)
 {
 	{
-		Glib::Threads::RWLock::WriterLock lm (lock);
+		MapWriterLock lm (*this);
 
 		XMLNodeList nlist;
 		XMLNodeConstIterator niter;
@@ -4840,7 +5070,7 @@ TempoMap::remove_time (samplepos_t where, samplecnt_t amount)
 	bool tempo_after = false; // is there a tempo marker at the first sample after the removed range?
 	bool meter_after = false; // is there a meter marker likewise?
 	{
-		Glib::Threads::RWLock::WriterLock lm (lock);
+		MapWriterLock lm (*this);
 		for (Metrics::iterator i = _metrics.begin(); i != _metrics.end(); ++i) {
 			if ((*i)->sample() >= where && (*i)->sample() < where+amount) {
 				metric_kill_list.push_back(*i);
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "ardour/playlist.h"
+#include "ardour/region.h"
+#include "ardour/audioplaylist.h"
+#include "ardour/audioregion.h"
+#include "audio_playlist_playback_map_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (AudioPlaylistPlaybackMapTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+namespace {
+
+/** Sort by descending layer and then by ascending position, as AudioPlaylist::read does */
+struct ReadSorter {
+	bool operator() (boost::shared_ptr<Region> a, boost::shared_ptr<Region> b) {
+		if (a->layer () != b->layer ()) {
+			return a->layer () > b->layer ();
+		}
+		return a->position () < b->position ();
+	}
+};
+
+} // anonymous namespace
+
+void
+AudioPlaylistPlaybackMapTest::setUp ()
+{
+	AudioRegionTest::setUp ();
+
+	_N = 1024;
+	_buf = new Sample[_N];
+	_ref = new Sample[_N];
+	_mbuf = new Sample[_N];
+	_gbuf = new float[_N];
+}
+
+void
+AudioPlaylistPlaybackMapTest::tearDown ()
+{
+	delete[] _buf;
+	delete[] _ref;
+	delete[] _mbuf;
+	delete[] _gbuf;
+
+	AudioRegionTest::tearDown ();
+}
+
+/** Read a range with the layering rules of find_segments (): a region
+ *  is read at a sample if it covers it, and no opaque region which is read
+ *  before it has its body there. This is checked one sample at a time,
+ *  Evoral::subtract () would not remove single-sample ranges.
+ */
+void
+AudioPlaylistPlaybackMapTest::read_reference (Sample* buf, samplepos_t start, samplecnt_t cnt)
+{
+	memset (buf, 0, sizeof (Sample) * cnt);
+
+	boost::shared_ptr<RegionList> all = _playlist->regions_touched (start, start + cnt - 1);
+	all->sort (ReadSorter ());
+
+	vector<boost::shared_ptr<AudioRegion> > layered;
+
+	for (RegionList::const_iterator i = all->begin (); i != all->end (); ++i) {
+		boost::shared_ptr<AudioRegion> ar = boost::dynamic_pointer_cast<AudioRegion> (*i);
+		if (!ar->muted ()) {
+			layered.push_back (ar);
+		}
+	}
+
+	vector<vector<bool> > audible (layered.size (), vector<bool> (cnt, false));
+
+	for (samplecnt_t n = 0; n < cnt; ++n) {
+		samplepos_t const p = start + n;
+		for (size_t i = 0; i < layered.size (); ++i) {
+			if (!layered[i]->covers (p)) {
+				continue;
+			}
+			audible[i][n] = true;
+			if (layered[i]->opaque ()) {
+				Evoral::Range<samplepos_t> const body = layered[i]->body_range ();
+				if (p >= body.from && p <= body.to) {
+					break;
+				}
+			}
+		}
+	}
+
+	/* read bottom-most regions first */
+	for (size_t i = layered.size (); i > 0; --i) {
+		samplecnt_t n = 0;
+		while (n < cnt) {
+			if (!audible[i - 1][n]) {
+				++n;
+				continue;
+			}
+			samplecnt_t const from = n;
+			while (n < cnt && audible[i - 1][n]) {
+				++n;
+			}
+			layered[i - 1]->read_at (buf + from, _mbuf, _gbuf, start + from, n - from, 0);
+		}
+	}
+}
+
+/** Compare playlist reads of the whole buffer, and of smaller
+ *  windows, with read_reference ().
+ */
+void
+AudioPlaylistPlaybackMapTest::check_against_reference ()
+{
+	int const windows[] = { _N, 61, 7 };
+
+	for (size_t w = 0; w < sizeof (windows) / sizeof (windows[0]); ++w) {
+		for (int s = 0; s + windows[w] <= _N; s += windows[w]) {
+			_audio_playlist->read (_buf, _mbuf, _gbuf, s, windows[w], 0);
+			read_reference (_ref, s, windows[w]);
+
+			for (int i = 0; i < windows[w]; ++i) {
+				/* segments may be split differently, which may round fades differently */
+				CPPUNIT_ASSERT_DOUBLES_EQUAL (_ref[i], _buf[i], 1e-4 * max (1.f, fabsf (_ref[i])));
+			}
+		}
+	}
+}
+
+void
+AudioPlaylistPlaybackMapTest::layeringTest ()
+{
+	/* Overlapping opaque and transparent regions, with and without fades */
+
+	uint32_t seed = 17;
+
+	for (int i = 0; i < 12; ++i) {
+		seed = seed * 1103515245 + 12345;
+		samplepos_t const pos = (seed >> 8) % 800;
+		seed = seed * 1103515245 + 12345;
+		samplecnt_t const len = 20 + (seed >> 8) % 300;
+
+		_audio_playlist->add_region (_ar[i], pos);
+		_ar[i]->set_length (len, 0);
+		_ar[i]->set_scale_amplitude (i + 1);
+		_ar[i]->set_opaque (i % 3 != 1);
+
+		if (i % 2) {
+			_ar[i]->set_fade_in_length (len / 4);
+			_ar[i]->set_fade_out_length (len / 3);
+			_ar[i]->set_fade_in_active (true);
+			_ar[i]->set_fade_out_active (true);
+		} else {
+			_ar[i]->set_fade_in_active (false);
+			_ar[i]->set_fade_out_active (false);
+		}
+	}
+
+	check_against_reference ();
+}
+
+void
+AudioPlaylistPlaybackMapTest::equalPositionTest ()
+{
+	/* Regions which start or end together, and regions on the same layer */
+
+	for (int i = 0; i < 4; ++i) {
+		_audio_playlist->add_region (_ar[i], 100);
+		_ar[i]->set_length (100 + 50 * i, 0);
+		_ar[i]->set_scale_amplitude (i + 1);
+	}
+
+	_ar[1]->set_opaque (false);
+	_ar[1]->set_default_fade_in ();
+	_ar[1]->set_default_fade_out ();
+
+	/* end together with _ar[3] */
+	_audio_playlist->add_region (_ar[4], 300);
+	_ar[4]->set_length (100, 0);
+	_ar[4]->set_scale_amplitude (5);
+
+	/* not overlapping each other, so they may share a layer */
+	for (int i = 5; i < 9; ++i) {
+		_audio_playlist->add_region (_ar[i], 500 + 100 * (i - 5));
+		_ar[i]->set_length (100, 0);
+		_ar[i]->set_scale_amplitude (i + 1);
+		_ar[i]->set_default_fade_in ();
+		_ar[i]->set_default_fade_out ();
+	}
+
+	CPPUNIT_ASSERT_EQUAL (_ar[5]->layer (), _ar[6]->layer ());
+
+	check_against_reference ();
+}
+
+void
+AudioPlaylistPlaybackMapTest::editTest ()
+{
+	/* Edits after a read must not use the previous map */
+
+	for (int i = 0; i < 8; ++i) {
+		_audio_playlist->add_region (_ar[i], 90 * i);
+		_ar[i]->set_length (200, 0);
+		_ar[i]->set_scale_amplitude (i + 1);
+		_ar[i]->set_default_fade_in ();
+		_ar[i]->set_default_fade_out ();
+	}
+
+	check_against_reference ();
+
+	_ar[3]->set_position (20);
+	check_against_reference ();
+
+	_ar[5]->set_opaque (false);
+	check_against_reference ();
+
+	_audio_playlist->lower_region_to_bottom (_ar[6]);
+	check_against_reference ();
+
+	_ar[2]->trim_front (250);
+	_ar[7]->set_length (50, 0);
+	check_against_reference ();
+
+	_ar[4]->set_muted (true);
+	check_against_reference ();
+
+	_audio_playlist->remove_region (_ar[0]);
+	check_against_reference ();
+}
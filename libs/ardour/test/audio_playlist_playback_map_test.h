@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "ardour/types.h"
+#include "audio_region_test.h"
+
+class AudioPlaylistPlaybackMapTest : public AudioRegionTest
+{
+	CPPUNIT_TEST_SUITE (AudioPlaylistPlaybackMapTest);
+	CPPUNIT_TEST (layeringTest);
+	CPPUNIT_TEST (equalPositionTest);
+	CPPUNIT_TEST (editTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void layeringTest ();
+	void equalPositionTest ();
+	void editTest ();
+
+private:
+	int _N;
+	ARDOUR::Sample* _buf;
+	ARDOUR::Sample* _ref;
+	ARDOUR::Sample* _mbuf;
+	float* _gbuf;
+
+	void read_reference (ARDOUR::Sample*, ARDOUR::samplepos_t, ARDOUR::samplecnt_t);
+	void check_against_reference ();
+};
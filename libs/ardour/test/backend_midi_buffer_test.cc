@@ -0,0 +1,110 @@
+#include "ardour/port_engine_shared.h"
+
+#include "backend_midi_buffer_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (BackendMidiBufferTest);
+
+using namespace ARDOUR;
+
+void
+BackendMidiBufferTest::pushTest ()
+{
+	BackendMidiBuffer buf;
+	uint8_t const on[3]  = { 0x90, 0x40, 0x7f };
+	uint8_t const off[3] = { 0x80, 0x40, 0x00 };
+	uint8_t const clk[1] = { 0xf8 };
+
+	CPPUNIT_ASSERT (buf.push_back (10, on, 3));
+	CPPUNIT_ASSERT (buf.push_back (20, off, 3));
+	/* late events are sorted in, after events at the same time */
+	CPPUNIT_ASSERT (buf.push_back (10, clk, 1));
+
+	CPPUNIT_ASSERT_EQUAL (size_t (3), buf.size ());
+	CPPUNIT_ASSERT_EQUAL (pframes_t (10), buf.timestamp (0));
+	CPPUNIT_ASSERT_EQUAL (size_t (3), buf.event_size (0));
+	CPPUNIT_ASSERT_EQUAL (pframes_t (10), buf.timestamp (1));
+	CPPUNIT_ASSERT_EQUAL (size_t (1), buf.event_size (1));
+	CPPUNIT_ASSERT_EQUAL (uint8_t (0xf8), buf.data (1)[0]);
+	CPPUNIT_ASSERT_EQUAL (pframes_t (20), buf.timestamp (2));
+	CPPUNIT_ASSERT_EQUAL (uint8_t (0x80), buf.data (2)[0]);
+
+	buf.clear ();
+	CPPUNIT_ASSERT (buf.empty ());
+}
+
+void
+BackendMidiBufferTest::mergeTest ()
+{
+	BackendMidiBuffer a;
+	BackendMidiBuffer b;
+	BackendMidiBuffer dst;
+
+	for (uint8_t i = 0; i < 8; ++i) {
+		uint8_t const cc[3] = { 0xb0, 1, i };
+		a.push_back (i * 10, cc, 3);
+		uint8_t const pb[3] = { 0xe0, 0, i };
+		b.push_back (i * 10 + 5, pb, 3);
+	}
+
+	CPPUNIT_ASSERT_EQUAL (size_t (0), dst.merge (a));
+	CPPUNIT_ASSERT_EQUAL (size_t (0), dst.merge (b));
+	CPPUNIT_ASSERT_EQUAL (size_t (0), dst.merge (a));
+
+	CPPUNIT_ASSERT_EQUAL (size_t (24), dst.size ());
+	for (size_t i = 1; i < dst.size (); ++i) {
+		CPPUNIT_ASSERT (dst.timestamp (i - 1) <= dst.timestamp (i));
+	}
+
+	/* events at the same time retain the order of the merges */
+	CPPUNIT_ASSERT_EQUAL (pframes_t (0), dst.timestamp (0));
+	CPPUNIT_ASSERT_EQUAL (pframes_t (0), dst.timestamp (1));
+	CPPUNIT_ASSERT_EQUAL (pframes_t (5), dst.timestamp (2));
+	CPPUNIT_ASSERT_EQUAL (uint8_t (0xe0), dst.data (2)[0]);
+	CPPUNIT_ASSERT_EQUAL (uint8_t (7), dst.data (23)[2]);
+
+	BackendMidiBuffer copy;
+	copy.copy (b);
+	CPPUNIT_ASSERT_EQUAL (b.size (), copy.size ());
+	CPPUNIT_ASSERT_EQUAL (pframes_t (75), copy.timestamp (7));
+}
+
+void
+BackendMidiBufferTest::capacityTest ()
+{
+	BackendMidiBuffer buf (4, 8);
+	uint8_t const ev[3] = { 0x90, 0x40, 0x7f };
+
+	CPPUNIT_ASSERT (buf.push_back (0, ev, 3));
+	CPPUNIT_ASSERT (buf.push_back (1, ev, 3));
+	/* out of data space */
+	CPPUNIT_ASSERT (!buf.push_back (2, ev, 3));
+	CPPUNIT_ASSERT (buf.push_back (2, ev, 1));
+	CPPUNIT_ASSERT (buf.push_back (3, ev, 1));
+	/* out of events */
+	CPPUNIT_ASSERT (!buf.push_back (4, ev, 0));
+	CPPUNIT_ASSERT_EQUAL (size_t (4), buf.size ());
+
+	BackendMidiBuffer other;
+	other.push_back (0, ev, 3);
+	CPPUNIT_ASSERT_EQUAL (size_t (1), buf.merge (other));
+	CPPUNIT_ASSERT_EQUAL (size_t (4), buf.size ());
+
+	/* the earliest events that fit are merged */
+	BackendMidiBuffer part (3, 8);
+	uint8_t const clk[1] = { 0xf8 };
+	CPPUNIT_ASSERT (part.push_back (5, clk, 1));
+
+	other.clear ();
+	CPPUNIT_ASSERT (other.push_back (6, ev, 3));
+	CPPUNIT_ASSERT (other.push_back (2, ev, 3));
+	CPPUNIT_ASSERT (other.push_back (9, ev, 3));
+
+	CPPUNIT_ASSERT_EQUAL (size_t (1), part.merge (other));
+	CPPUNIT_ASSERT_EQUAL (size_t (3), part.size ());
+	CPPUNIT_ASSERT_EQUAL (pframes_t (2), part.timestamp (0));
+	CPPUNIT_ASSERT_EQUAL (uint8_t (0x90), part.data (0)[0]);
+	CPPUNIT_ASSERT_EQUAL (pframes_t (5), part.timestamp (1));
+	CPPUNIT_ASSERT_EQUAL (uint8_t (0xf8), part.data (1)[0]);
+	CPPUNIT_ASSERT_EQUAL (pframes_t (6), part.timestamp (2));
+	CPPUNIT_ASSERT_EQUAL (uint8_t (0x7f), part.data (2)[2]);
+}
@@ -0,0 +1,16 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class BackendMidiBufferTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (BackendMidiBufferTest);
+	CPPUNIT_TEST (pushTest);
+	CPPUNIT_TEST (mergeTest);
+	CPPUNIT_TEST (capacityTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void pushTest ();
+	void mergeTest ();
+	void capacityTest ();
+};
@@ -1,4 +1,5 @@
 #include <cassert>
+#include <cstring>
 #include "pbd/compose.h"
 #include "pbd/fpu.h"
 #include "pbd/malign.h"
@@ -25,6 +26,9 @@ FPUTest::setUp ()
 		_test2[i] = _comp2[i] = 2.5 / (i + 1.0);
 	}
 
+	kmeter_process  = 0;
+	ppm_process     = 0;
+	vumeter_process = 0;
 }
 
 void
@@ -83,6 +87,75 @@ FPUTest::run (size_t align_max)
 			CPPUNIT_ASSERT_MESSAGE (string_compose ("Find peaks not aligned off: %1 cnt: %2", off, cnt), fabsf (pk_test - pk_comp) < 2e-6 && fabsf (pk_test_max - pk_comp_max) < 2e-6);
 		}
 	}
+
+	if (kmeter_process) {
+		run_meters ();
+	}
+}
+
+/* the SIMD kernels perform the same operations in the same order
+ * as the scalar code, results must be bit-identical */
+static bool
+meter_state_equal (float const* a, float const* b, uint32_t n_chn)
+{
+	return memcmp (a, b, n_chn * sizeof (float)) == 0;
+}
+
+void
+FPUTest::run_meters ()
+{
+	/* covers groups of 4 and 8 channels, as well as any remainder */
+	const uint32_t max_chn  = 19;
+	const uint32_t n_frames = 256;
+	const float    rate     = 48000;
+
+	float        data[max_chn * 8 + n_frames];
+	float const* src[max_chn];
+
+	for (size_t i = 0; i < sizeof (data) / sizeof (float); ++i) {
+		data[i] = sinf (i * .1f) * (1 + i % 3);
+	}
+	for (uint32_t c = 0; c < max_chn; ++c) {
+		/* mostly unaligned */
+		src[c] = &data[c * 7 % (max_chn * 8)];
+	}
+
+	float z1_test[max_chn], z2_test[max_chn], m_test[max_chn];
+	float z1_comp[max_chn], z2_comp[max_chn], m_comp[max_chn];
+
+	for (uint32_t n_chn = 1; n_chn <= max_chn; ++n_chn) {
+		for (uint32_t c = 0; c < n_chn; ++c) {
+			z1_test[c] = z1_comp[c] = .01f * c;
+			z2_test[c] = z2_comp[c] = .02f * c;
+		}
+		for (int cycle = 0; cycle < 4; ++cycle) {
+			kmeter_process (src, n_chn, n_frames, 9.72f / rate, z1_test, z2_test);
+			default_kmeter_process (src, n_chn, n_frames, 9.72f / rate, z1_comp, z2_comp);
+		}
+		CPPUNIT_ASSERT_MESSAGE (string_compose ("K-meter channels: %1", n_chn), meter_state_equal (z1_test, z1_comp, n_chn) && meter_state_equal (z2_test, z2_comp, n_chn));
+
+		for (uint32_t c = 0; c < n_chn; ++c) {
+			z1_test[c] = z1_comp[c] = .01f * c;
+			z2_test[c] = z2_comp[c] = .02f * c;
+			m_test[c]  = m_comp[c]  = 0;
+		}
+		for (int cycle = 0; cycle < 4; ++cycle) {
+			ppm_process (src, n_chn, n_frames, 450.f / rate, 1300.f / rate, 1.f - 5.4f / rate, z1_test, z2_test, m_test);
+			default_ppm_process (src, n_chn, n_frames, 450.f / rate, 1300.f / rate, 1.f - 5.4f / rate, z1_comp, z2_comp, m_comp);
+		}
+		CPPUNIT_ASSERT_MESSAGE (string_compose ("PPM channels: %1", n_chn), meter_state_equal (z1_test, z1_comp, n_chn) && meter_state_equal (z2_test, z2_comp, n_chn) && meter_state_equal (m_test, m_comp, n_chn));
+
+		for (uint32_t c = 0; c < n_chn; ++c) {
+			z1_test[c] = z1_comp[c] = -.01f * c;
+			z2_test[c] = z2_comp[c] = .02f * c;
+			m_test[c]  = m_comp[c]  = 0;
+		}
+		for (int cycle = 0; cycle < 4; ++cycle) {
+			vumeter_process (src, n_chn, n_frames, 11.1f / rate, z1_test, z2_test, m_test);
+			default_vumeter_process (src, n_chn, n_frames, 11.1f / rate, z1_comp, z2_comp, m_comp);
+		}
+		CPPUNIT_ASSERT_MESSAGE (string_compose ("VU-meter channels: %1", n_chn), meter_state_equal (z1_test, z1_comp, n_chn) && meter_state_equal (z2_test, z2_comp, n_chn) && meter_state_equal (m_test, m_comp, n_chn));
+	}
 }
 
 void
@@ -122,6 +195,11 @@ FPUTest::avxFmaTest ()
 	mix_buffers_with_gain = x86_fma_mix_buffers_with_gain;
 	mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 	copy_vector           = x86_sse_avx_copy_vector;
+#ifndef PLATFORM_WINDOWS
+	kmeter_process        = x86_sse_avx_kmeter_process;
+	ppm_process           = x86_sse_avx_ppm_process;
+	vumeter_process       = x86_sse_avx_vumeter_process;
+#endif
 
 	run (align_max);
 }
@@ -149,6 +227,11 @@ FPUTest::avxTest ()
 	mix_buffers_with_gain = x86_sse_avx_mix_buffers_with_gain;
 	mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 	copy_vector           = x86_sse_avx_copy_vector;
+#ifndef PLATFORM_WINDOWS
+	kmeter_process        = x86_sse_avx_kmeter_process;
+	ppm_process           = x86_sse_avx_ppm_process;
+	vumeter_process       = x86_sse_avx_vumeter_process;
+#endif
 
 	run (align_max);
 }
@@ -176,6 +259,9 @@ FPUTest::sseTest ()
 	mix_buffers_with_gain = x86_sse_mix_buffers_with_gain;
 	mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
 	copy_vector           = default_copy_vector;
+	kmeter_process        = x86_sse_kmeter_process;
+	ppm_process           = x86_sse_ppm_process;
+	vumeter_process       = x86_sse_vumeter_process;
 
 	run (align_max);
 }
@@ -37,6 +37,7 @@ public:
 
 private:
 	void run (size_t);
+	void run_meters ();
 	void compare (std::string, size_t);
 
 	ARDOUR::compute_peak_t          compute_peak;
@@ -45,6 +46,9 @@ private:
 	ARDOUR::mix_buffers_with_gain_t mix_buffers_with_gain;
 	ARDOUR::mix_buffers_no_gain_t   mix_buffers_no_gain;
 	ARDOUR::copy_vector_t           copy_vector;
+	ARDOUR::kmeter_process_t        kmeter_process;
+	ARDOUR::ppm_process_t           ppm_process;
+	ARDOUR::vumeter_process_t       vumeter_process;
 
 	size_t _size;
 
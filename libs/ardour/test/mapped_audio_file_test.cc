@@ -0,0 +1,316 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include <glibmm/miscutils.h>
+#include <sndfile.h>
+
+#include "ardour/mapped_audio_file.h"
+#include "mapped_audio_file_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MappedAudioFileTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+namespace {
+
+void
+put_tag (vector<uint8_t>& v, char const* tag)
+{
+	v.insert (v.end (), tag, tag + 4);
+}
+
+void
+put_le (vector<uint8_t>& v, uint64_t x, int bytes)
+{
+	for (int i = 0; i < bytes; ++i) {
+		v.push_back ((x >> (8 * i)) & 0xff);
+	}
+}
+
+void
+put_be (vector<uint8_t>& v, uint64_t x, int bytes)
+{
+	for (int i = bytes - 1; i >= 0; --i) {
+		v.push_back ((x >> (8 * i)) & 0xff);
+	}
+}
+
+void
+set_le (vector<uint8_t>& v, size_t pos, uint64_t x, int bytes)
+{
+	for (int i = 0; i < bytes; ++i) {
+		v[pos + i] = (x >> (8 * i)) & 0xff;
+	}
+}
+
+/** Append little-endian interleaved samples, each channel with its own signal */
+void
+put_samples (vector<uint8_t>& v, uint32_t bits, bool is_float, uint32_t channels, samplecnt_t frames)
+{
+	for (samplecnt_t n = 0; n < frames; ++n) {
+		for (uint32_t c = 0; c < channels; ++c) {
+			uint64_t const x = (n * 97 + c * 4099) * 1301;
+			if (is_float) {
+				float const f = sinf (n * 0.01f * (c + 1)) * 0.9f;
+				uint32_t u;
+				memcpy (&u, &f, sizeof (float));
+				put_le (v, u, 4);
+			} else {
+				put_le (v, x, bits / 8);
+			}
+		}
+	}
+}
+
+void
+write_file (std::string const& path, vector<uint8_t> const& v)
+{
+	ofstream f (path.c_str (), ios::binary);
+	f.write ((char const*) &v[0], v.size ());
+}
+
+} // anonymous namespace
+
+void
+MappedAudioFileTest::setUp ()
+{
+	_dir = new_test_output_dir ("mapped_audio_file");
+}
+
+/** Write a WAV or RF64 file.
+ *  @param odd_chunk add odd-sized chunks before and after the fmt chunk.
+ *  @param truncate number of bytes to cut off the end of the file.
+ */
+std::string
+MappedAudioFileTest::write_wav (std::string const& name, uint16_t format, uint32_t bits, uint32_t channels, samplecnt_t frames, bool rf64, bool odd_chunk, size_t truncate)
+{
+	uint32_t const block_align = channels * bits / 8;
+	uint64_t const data_size   = frames * block_align;
+	bool const     is_float    = format == 3 || (format == 0xfffe && bits == 32);
+
+	vector<uint8_t> v;
+
+	put_tag (v, rf64 ? "RF64" : "RIFF");
+	put_le (v, rf64 ? 0xffffffff : 0, 4);
+	put_tag (v, "WAVE");
+
+	size_t riff_size = 4;
+
+	if (rf64) {
+		put_tag (v, "ds64");
+		put_le (v, 28, 4);
+		riff_size = v.size ();
+		put_le (v, 0, 8);
+		put_le (v, data_size, 8);
+		put_le (v, frames, 8);
+		put_le (v, 0, 4);
+	}
+
+	if (odd_chunk) {
+		put_tag (v, "JUNK");
+		put_le (v, 7, 4);
+		v.insert (v.end (), 8, 0);
+	}
+
+	put_tag (v, "fmt ");
+	put_le (v, format == 0xfffe ? 40 : 16, 4);
+	put_le (v, format, 2);
+	put_le (v, channels, 2);
+	put_le (v, 48000, 4);
+	put_le (v, 48000 * block_align, 4);
+	put_le (v, block_align, 2);
+	put_le (v, bits, 2);
+
+	if (format == 0xfffe) {
+		static uint8_t const guid[] = { 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71 };
+		put_le (v, 22, 2);
+		put_le (v, bits, 2);
+		put_le (v, 0, 4);
+		put_le (v, is_float ? 3 : 1, 2);
+		v.insert (v.end (), guid, guid + sizeof (guid));
+	}
+
+	if (odd_chunk) {
+		put_tag (v, "JUNK");
+		put_le (v, 3, 4);
+		v.insert (v.end (), 4, 0);
+	}
+
+	put_tag (v, "data");
+	put_le (v, rf64 ? 0xffffffff : data_size, 4);
+	put_samples (v, bits, is_float, channels, frames);
+
+	if (data_size & 1) {
+		v.push_back (0);
+	}
+
+	set_le (v, riff_size, v.size () - 8, rf64 ? 8 : 4);
+	v.resize (v.size () - truncate);
+
+	std::string const path = Glib::build_filename (_dir, name);
+	write_file (path, v);
+	return path;
+}
+
+/** Write a CAF file with linear PCM data.
+ *  @param unknown_size write a data chunk size of -1, meaning "until the end of the file".
+ */
+std::string
+MappedAudioFileTest::write_caf (std::string const& name, uint32_t bits, bool is_float, bool little_endian, uint32_t channels, samplecnt_t frames, bool unknown_size)
+{
+	uint64_t const data_size = frames * channels * bits / 8;
+	double const   rate      = 48000;
+	uint64_t       rate_bits;
+
+	memcpy (&rate_bits, &rate, sizeof (double));
+
+	vector<uint8_t> v;
+
+	put_tag (v, "caff");
+	put_be (v, 1, 2);
+	put_be (v, 0, 2);
+
+	put_tag (v, "desc");
+	put_be (v, 32, 8);
+	put_be (v, rate_bits, 8);
+	put_tag (v, "lpcm");
+	put_be (v, (is_float ? 1 : 0) | (little_endian ? 2 : 0), 4);
+	put_be (v, channels * bits / 8, 4);
+	put_be (v, 1, 4);
+	put_be (v, channels, 4);
+	put_be (v, bits, 4);
+
+	put_tag (v, "data");
+	put_be (v, unknown_size ? (uint64_t) -1 : data_size + 4, 8);
+	put_be (v, 0, 4);
+	put_samples (v, bits, is_float, channels, frames);
+
+	std::string const path = Glib::build_filename (_dir, name);
+	write_file (path, v);
+	return path;
+}
+
+/** Compare the mapped file with a read by libsndfile */
+void
+MappedAudioFileTest::check_against_sndfile (std::string const& path, uint32_t channels, samplecnt_t frames)
+{
+	if (sizeof (void*) < 8) {
+		/* not mapped on 32 bit hosts */
+		return;
+	}
+
+	SF_INFO info;
+	memset (&info, 0, sizeof (info));
+
+	SNDFILE* sf = sf_open (path.c_str (), SFM_READ, &info);
+	CPPUNIT_ASSERT (sf);
+	CPPUNIT_ASSERT_EQUAL ((int) channels, info.channels);
+	CPPUNIT_ASSERT_EQUAL ((sf_count_t) frames, info.frames);
+
+	vector<float> ref (frames * channels);
+	CPPUNIT_ASSERT_EQUAL ((sf_count_t) frames, sf_readf_float (sf, &ref[0], frames));
+	sf_close (sf);
+
+	MappedAudioFile* maf = MappedAudioFile::open (path);
+	CPPUNIT_ASSERT (maf);
+	CPPUNIT_ASSERT_EQUAL (channels, maf->channels ());
+	CPPUNIT_ASSERT_EQUAL (frames, maf->length ());
+
+	vector<Sample> buf (frames);
+
+	for (uint32_t c = 0; c < channels; ++c) {
+		CPPUNIT_ASSERT_EQUAL (frames, maf->read (&buf[0], 0, frames, c, 1.f));
+		for (samplecnt_t n = 0; n < frames; ++n) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (ref[n * channels + c], buf[n], 1e-7);
+		}
+
+		/* partial read at the end of the file, with gain */
+		samplecnt_t const start = frames - 10;
+		CPPUNIT_ASSERT_EQUAL ((samplecnt_t) 10, maf->read (&buf[0], start, 100, c, .5f));
+		for (samplecnt_t n = 0; n < 10; ++n) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (ref[(start + n) * channels + c] * .5f, buf[n], 1e-7);
+		}
+	}
+
+	CPPUNIT_ASSERT_EQUAL ((samplecnt_t) 0, maf->read (&buf[0], frames, 1, 0, 1.f));
+	CPPUNIT_ASSERT_EQUAL ((samplecnt_t) 0, maf->read (&buf[0], 0, 1, channels, 1.f));
+
+	delete maf;
+}
+
+void
+MappedAudioFileTest::wavTest ()
+{
+	check_against_sndfile (write_wav ("int16.wav", 1, 16, 2, 1000, false, false), 2, 1000);
+	check_against_sndfile (write_wav ("int24.wav", 1, 24, 2, 1000, false, false), 2, 1000);
+	check_against_sndfile (write_wav ("float.wav", 3, 32, 2, 1000, false, false), 2, 1000);
+	check_against_sndfile (write_wav ("mono.wav", 3, 32, 1, 1000, false, false), 1, 1000);
+}
+
+void
+MappedAudioFileTest::extensibleTest ()
+{
+	check_against_sndfile (write_wav ("ext-int16.wav", 0xfffe, 16, 2, 1000, false, false), 2, 1000);
+	check_against_sndfile (write_wav ("ext-int24.wav", 0xfffe, 24, 6, 1000, false, false), 6, 1000);
+	check_against_sndfile (write_wav ("ext-float.wav", 0xfffe, 32, 2, 1000, false, false), 2, 1000);
+}
+
+void
+MappedAudioFileTest::paddingTest ()
+{
+	/* odd-sized chunks before the data, and odd-sized data */
+	check_against_sndfile (write_wav ("odd.wav", 1, 24, 3, 1001, false, true), 3, 1001);
+}
+
+void
+MappedAudioFileTest::rf64Test ()
+{
+	check_against_sndfile (write_wav ("int24.rf64", 1, 24, 2, 1000, true, false), 2, 1000);
+	check_against_sndfile (write_wav ("float.rf64", 0xfffe, 32, 2, 1000, true, true), 2, 1000);
+}
+
+void
+MappedAudioFileTest::cafTest ()
+{
+	check_against_sndfile (write_caf ("int16.caf", 16, false, true, 2, 1000, false), 2, 1000);
+	check_against_sndfile (write_caf ("int24.caf", 24, false, true, 3, 1000, false), 3, 1000);
+	check_against_sndfile (write_caf ("float.caf", 32, true, true, 2, 1000, false), 2, 1000);
+	check_against_sndfile (write_caf ("unknown-size.caf", 32, true, true, 2, 1000, true), 2, 1000);
+}
+
+void
+MappedAudioFileTest::truncatedTest ()
+{
+	/* the data chunk claims 1000 frames, but the file ends within frame 899 */
+	check_against_sndfile (write_wav ("truncated.wav", 1, 16, 2, 1000, false, false, 100 * 4 + 1), 2, 899);
+}
+
+void
+MappedAudioFileTest::unsupportedTest ()
+{
+	CPPUNIT_ASSERT (!MappedAudioFile::open (write_wav ("int8.wav", 1, 8, 2, 1000, false, false)));
+	CPPUNIT_ASSERT (!MappedAudioFile::open (write_wav ("adpcm.wav", 2, 16, 2, 1000, false, false)));
+	CPPUNIT_ASSERT (!MappedAudioFile::open (write_caf ("big-endian.caf", 16, false, false, 2, 1000, false)));
+	CPPUNIT_ASSERT (!MappedAudioFile::open (Glib::build_filename (_dir, "does-not-exist.wav")));
+}
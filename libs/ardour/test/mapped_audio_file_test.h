@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "ardour/types.h"
+
+class MappedAudioFileTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (MappedAudioFileTest);
+	CPPUNIT_TEST (wavTest);
+	CPPUNIT_TEST (extensibleTest);
+	CPPUNIT_TEST (paddingTest);
+	CPPUNIT_TEST (rf64Test);
+	CPPUNIT_TEST (cafTest);
+	CPPUNIT_TEST (truncatedTest);
+	CPPUNIT_TEST (unsupportedTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+
+	void wavTest ();
+	void extensibleTest ();
+	void paddingTest ();
+	void rf64Test ();
+	void cafTest ();
+	void truncatedTest ();
+	void unsupportedTest ();
+
+private:
+	std::string _dir;
+
+	std::string write_wav (std::string const& name, uint16_t format, uint32_t bits, uint32_t channels, ARDOUR::samplecnt_t frames, bool rf64, bool odd_chunk, size_t truncate = 0);
+	std::string write_caf (std::string const& name, uint32_t bits, bool is_float, bool little_endian, uint32_t channels, ARDOUR::samplecnt_t frames, bool unknown_size);
+	void check_against_sndfile (std::string const& path, uint32_t channels, ARDOUR::samplecnt_t frames);
+};
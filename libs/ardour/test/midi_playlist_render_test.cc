@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <glibmm/miscutils.h>
+
+#include "pbd/compose.h"
+
+#include "evoral/EventList.h"
+
+#include "ardour/midi_buffer.h"
+#include "ardour/midi_model.h"
+#include "ardour/midi_playlist.h"
+#include "ardour/midi_region.h"
+#include "ardour/midi_source.h"
+#include "ardour/midi_state_tracker.h"
+#include "ardour/parameter_types.h"
+#include "ardour/playlist_factory.h"
+#include "ardour/region_factory.h"
+#include "ardour/rt_midibuffer.h"
+#include "ardour/session.h"
+#include "ardour/source_factory.h"
+#include "ardour/tempo.h"
+
+#include "midi_playlist_render_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MidiPlaylistRenderTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+void
+MidiPlaylistRenderTest::setUp ()
+{
+	TestNeedingSession::setUp ();
+
+	std::string const test_mid_path = Glib::build_filename (new_test_output_dir (), "test.mid");
+
+	_playlist = boost::dynamic_pointer_cast<MidiPlaylist> (PlaylistFactory::create (DataType::MIDI, *_session, "test"));
+	_source = boost::dynamic_pointer_cast<MidiSource> (SourceFactory::createWritable (DataType::MIDI, *_session, test_mid_path, get_test_sample_rate ()));
+
+	/* a note on every beat, 16 beats */
+	boost::shared_ptr<MidiModel> model = _source->model ();
+	MidiModel::NoteDiffCommand*  cmd   = model->new_note_diff_command ("add notes");
+
+	for (int i = 0; i < 16; ++i) {
+		cmd->add (MidiModel::NotePtr (new Evoral::Note<Temporal::Beats> (0, Temporal::Beats (i), Temporal::Beats (0.5), 60 + i, 100)));
+	}
+	model->apply_command (*_session, cmd);
+
+	_beat = _session->tempo_map ().samples_per_quarter_note_at (0, get_test_sample_rate ());
+
+	PropertyList plist;
+	plist.add (Properties::start, 0);
+	plist.add (Properties::length, 16 * _beat);
+
+	for (int i = 0; i < 4; ++i) {
+		plist.add (Properties::name, string_compose ("mr%1", i));
+		_r[i] = boost::dynamic_pointer_cast<MidiRegion> (RegionFactory::create (_source, plist));
+	}
+}
+
+void
+MidiPlaylistRenderTest::tearDown ()
+{
+	_playlist.reset ();
+	_source.reset ();
+	for (int i = 0; i < 4; ++i) {
+		_r[i].reset ();
+	}
+
+	TestNeedingSession::tearDown ();
+}
+
+/** Read the events in [start, end) of a rendered buffer */
+void
+MidiPlaylistRenderTest::read (RTMidiBuffer& rtb, samplepos_t start, samplepos_t end, Events& events)
+{
+	MidiBuffer       buf (65536);
+	MidiStateTracker tracker;
+
+	rtb.read (buf, start, end, tracker);
+
+	events.clear ();
+	for (MidiBuffer::iterator i = buf.begin (); i != buf.end (); ++i) {
+		Event e;
+		e.time = (*i).time () + start;
+		e.data.assign ((*i).buffer (), (*i).buffer () + (*i).size ());
+		events.push_back (e);
+	}
+}
+
+/** Tempo-map edits that are not position drags (add_tempo, replace_tempo,
+ * ...) must invalidate rendered events.
+ */
+void
+MidiPlaylistRenderTest::tempoMapTest ()
+{
+	_playlist->add_region (_r[0], 0);
+
+	Events before;
+	_playlist->render (0);
+	read (*_playlist->rendered (), 0, max_samplepos, before);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 32, before.size ());
+
+	/* double the tempo: events after the first one move earlier */
+	TempoMap& map (_session->tempo_map ());
+	Tempo     t (map.first_tempo ());
+	map.replace_tempo (map.first_tempo (), Tempo (2 * t.note_types_per_minute (), t.note_type ()), 0.0, 0, AudioTime);
+
+	Events after;
+	_playlist->render (0);
+	read (*_playlist->rendered (), 0, max_samplepos, after);
+
+	CPPUNIT_ASSERT_EQUAL (before.size (), after.size ());
+	CPPUNIT_ASSERT_EQUAL (before[0].time, after[0].time);
+	for (size_t i = 2; i < after.size (); ++i) {
+		CPPUNIT_ASSERT (after[i].time < before[i].time);
+	}
+}
+
+namespace {
+
+/* the order MidiPlaylist::render () used to sort events of all regions in */
+struct SortByTimeAndType {
+	bool operator() (Evoral::Event<samplepos_t> const* a, Evoral::Event<samplepos_t> const* b) {
+		if (a->time () == b->time ()
+		    && parameter_is_midi ((AutomationType)a->event_type ())
+		    && parameter_is_midi ((AutomationType)b->event_type ())) {
+			return !MidiBuffer::second_simultaneous_midi_byte_is_first (a->buffer ()[0], b->buffer ()[0]);
+		}
+		return a->time () < b->time ();
+	}
+};
+
+}
+
+/** Render the playlist (using cached events where possible), and compare
+ * the result with rendering all regions from scratch and sorting their
+ * events, for the whole timeline and for partial ranges.
+ */
+void
+MidiPlaylistRenderTest::check_against_uncached ()
+{
+	_playlist->render (0);
+
+	Evoral::EventList<samplepos_t> evlist;
+	boost::shared_ptr<RegionList>  rl = _playlist->region_list ();
+
+	for (RegionList::const_iterator i = rl->begin (); i != rl->end (); ++i) {
+		boost::dynamic_pointer_cast<MidiRegion> (*i)->render (evlist, 0, Sustained, 0);
+	}
+
+	SortByTimeAndType cmp;
+	evlist.sort (cmp);
+
+	RTMidiBuffer reference;
+	for (Evoral::EventList<samplepos_t>::iterator e = evlist.begin (); e != evlist.end (); ++e) {
+		reference.write ((*e)->time (), (*e)->event_type (), (*e)->size (), (*e)->buffer ());
+		delete *e;
+	}
+
+	Events rendered;
+	Events expected;
+
+	read (*_playlist->rendered (), 0, max_samplepos, rendered);
+	read (reference, 0, max_samplepos, expected);
+	CPPUNIT_ASSERT (!expected.empty ());
+	CPPUNIT_ASSERT (rendered == expected);
+
+	for (samplepos_t s = 0; s < 24 * _beat; s += _beat / 3) {
+		read (*_playlist->rendered (), s, s + 2 * _beat, rendered);
+		read (reference, s, s + 2 * _beat, expected);
+		CPPUNIT_ASSERT (rendered == expected);
+	}
+}
+
+void
+MidiPlaylistRenderTest::cacheTest ()
+{
+	/* overlapping regions */
+	_playlist->add_region (_r[0], 0);
+	_playlist->add_region (_r[1], 2 * _beat);
+	_playlist->add_region (_r[2], 3 * _beat + _beat / 2);
+	_playlist->add_region (_r[3], 7 * _beat);
+
+	check_against_uncached ();
+	/* all regions cached */
+	check_against_uncached ();
+
+	_r[1]->set_position (5 * _beat + _beat / 4, 0);
+	check_against_uncached ();
+
+	_r[2]->trim_front (_r[2]->position () + 3 * _beat);
+	_r[0]->trim_end (6 * _beat);
+	check_against_uncached ();
+
+	/* edit the model that all regions use */
+	boost::shared_ptr<MidiModel> model = _source->model ();
+	MidiModel::NoteDiffCommand*  cmd   = model->new_note_diff_command ("add note");
+	cmd->add (MidiModel::NotePtr (new Evoral::Note<Temporal::Beats> (0, Temporal::Beats (4.5), Temporal::Beats (1), 40, 90)));
+	model->apply_command (*_session, cmd);
+	check_against_uncached ();
+
+	_playlist->remove_region (_r[3]);
+	check_against_uncached ();
+}
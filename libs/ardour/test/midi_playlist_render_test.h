@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "ardour/types.h"
+#include "test_needing_session.h"
+
+namespace ARDOUR {
+	class MidiPlaylist;
+	class MidiRegion;
+	class MidiSource;
+	class RTMidiBuffer;
+}
+
+class MidiPlaylistRenderTest : public TestNeedingSession
+{
+	CPPUNIT_TEST_SUITE (MidiPlaylistRenderTest);
+	CPPUNIT_TEST (tempoMapTest);
+	CPPUNIT_TEST (cacheTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void tempoMapTest ();
+	void cacheTest ();
+
+private:
+	struct Event {
+		ARDOUR::samplepos_t  time;
+		std::vector<uint8_t> data;
+		bool operator== (Event const& o) const { return time == o.time && data == o.data; }
+	};
+
+	typedef std::vector<Event> Events;
+
+	void read (ARDOUR::RTMidiBuffer&, ARDOUR::samplepos_t start, ARDOUR::samplepos_t end, Events&);
+	void check_against_uncached ();
+
+	ARDOUR::samplecnt_t _beat;
+
+	boost::shared_ptr<ARDOUR::MidiPlaylist> _playlist;
+	boost::shared_ptr<ARDOUR::MidiSource>   _source;
+	boost::shared_ptr<ARDOUR::MidiRegion>   _r[4];
+};
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "ardour/playlist.h"
+#include "ardour/region.h"
+#include "playlist_region_index_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PlaylistRegionIndexTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+/** Compare indexed lookups with a linear search of the region list */
+void
+PlaylistRegionIndexTest::check_against_list ()
+{
+	boost::shared_ptr<RegionList> all = _playlist->region_list ();
+
+	for (samplepos_t s = 0; s < 1000; s += 7) {
+		RegionList at;
+		RegionList touched;
+		RegionList start_within;
+		RegionList end_within;
+
+		for (RegionList::const_iterator i = all->begin (); i != all->end (); ++i) {
+			if ((*i)->covers (s)) {
+				at.push_back (*i);
+			}
+			if ((*i)->coverage (s, s + 50) != Evoral::OverlapNone) {
+				touched.push_back (*i);
+			}
+			if ((*i)->first_sample () >= s && (*i)->first_sample () <= s + 50) {
+				start_within.push_back (*i);
+			}
+			if ((*i)->last_sample () >= s && (*i)->last_sample () <= s + 50) {
+				end_within.push_back (*i);
+			}
+		}
+
+		CPPUNIT_ASSERT (*_playlist->regions_at (s) == at);
+		CPPUNIT_ASSERT_EQUAL ((uint32_t) at.size (), _playlist->count_regions_at (s));
+		CPPUNIT_ASSERT (*_playlist->regions_touched (s, s + 50) == touched);
+		CPPUNIT_ASSERT (*_playlist->regions_with_start_within (Evoral::Range<samplepos_t> (s, s + 50)) == start_within);
+		CPPUNIT_ASSERT (*_playlist->regions_with_end_within (Evoral::Range<samplepos_t> (s, s + 50)) == end_within);
+	}
+}
+
+void
+PlaylistRegionIndexTest::queryTest ()
+{
+	for (int i = 0; i < 16; ++i) {
+		_playlist->add_region (_r[i], (i * 37) % 500);
+	}
+
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 3, _playlist->count_regions_at (50));
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 0, _playlist->count_regions_at (700));
+
+	check_against_list ();
+}
+
+void
+PlaylistRegionIndexTest::moveTest ()
+{
+	for (int i = 0; i < 16; ++i) {
+		_playlist->add_region (_r[i], i * 50);
+	}
+
+	check_against_list ();
+
+	/* moving and trimming regions must update the index */
+	_r[0]->set_position (800);
+	_r[5]->trim_end (300);
+	_r[9]->set_length (10, 0);
+
+	CPPUNIT_ASSERT (_playlist->top_region_at (810) == _r[0]);
+	CPPUNIT_ASSERT (_playlist->regions_at (5)->empty ());
+
+	check_against_list ();
+
+	_playlist->remove_region (_r[3]);
+
+	check_against_list ();
+}
+
+/** count_regions_at () walks the index without collecting regions,
+ * check it for every sample against the region list.
+ */
+void
+PlaylistRegionIndexTest::countTest ()
+{
+	for (int i = 0; i < 16; ++i) {
+		_playlist->add_region (_r[i], (i * 29) % 300);
+	}
+	/* regions of different length */
+	_r[2]->set_length (1, 0);
+	_r[7]->trim_end (_r[7]->position () + 250);
+
+	boost::shared_ptr<RegionList> all = _playlist->region_list ();
+
+	for (samplepos_t s = 0; s < 700; ++s) {
+		uint32_t cnt = 0;
+		for (RegionList::const_iterator i = all->begin (); i != all->end (); ++i) {
+			if ((*i)->covers (s)) {
+				++cnt;
+			}
+		}
+		CPPUNIT_ASSERT_EQUAL (cnt, _playlist->count_regions_at (s));
+	}
+}
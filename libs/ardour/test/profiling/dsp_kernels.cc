@@ -0,0 +1,380 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <glib.h>
+
+#include "pbd/fpu.h"
+#include "pbd/malign.h"
+#include "pbd/timing.h"
+
+#include "ardour/mix.h"
+#include "ardour/runtime_functions.h"
+
+#if defined(__APPLE__)
+#include <CoreFoundation/CoreFoundation.h>
+#endif
+
+/* Benchmark and validate all variants of the DSP kernels that
+ * setup_hardware_optimization() can select at runtime.
+ *
+ * Every kernel is compared against the default (non-optimized) variant,
+ * and timed for a range of buffer sizes and alignments. Throughput is
+ * reported in samples per nanosecond.
+ */
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+struct KernelSet {
+	const char*             name;
+	compute_peak_t          compute_peak;
+	find_peaks_t            find_peaks;
+	apply_gain_to_buffer_t  apply_gain_to_buffer;
+	mix_buffers_with_gain_t mix_buffers_with_gain;
+	mix_buffers_no_gain_t   mix_buffers_no_gain;
+	copy_vector_t           copy_vector;
+};
+
+static const uint32_t max_size  = 8192;
+static const uint32_t max_align = 16; /* in samples, covers 64 byte alignment */
+
+static float* src_buf;
+static float* dst_buf;
+static float* ref_buf;
+
+static bool    validation_failed = false;
+static int64_t min_duration      = 100000; /* usec per measurement */
+
+static void
+available_kernels (vector<KernelSet>& k)
+{
+	KernelSet const generic = {
+		"default",
+		default_compute_peak,
+		default_find_peaks,
+		default_apply_gain_to_buffer,
+		default_mix_buffers_with_gain,
+		default_mix_buffers_no_gain,
+		default_copy_vector
+	};
+
+	k.push_back (generic);
+
+	FPU* fpu = FPU::instance ();
+
+#if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
+	if (fpu->has_sse ()) {
+		KernelSet const ks = {
+			"sse",
+			x86_sse_compute_peak,
+			x86_sse_find_peaks,
+			x86_sse_apply_gain_to_buffer,
+			x86_sse_mix_buffers_with_gain,
+			x86_sse_mix_buffers_no_gain,
+			default_copy_vector
+		};
+		k.push_back (ks);
+	}
+	if (fpu->has_avx ()) {
+		KernelSet const ks = {
+			"avx",
+			x86_sse_avx_compute_peak,
+			x86_sse_avx_find_peaks,
+			x86_sse_avx_apply_gain_to_buffer,
+			x86_sse_avx_mix_buffers_with_gain,
+			x86_sse_avx_mix_buffers_no_gain,
+			x86_sse_avx_copy_vector
+		};
+		k.push_back (ks);
+	}
+#ifdef FPU_AVX_FMA_SUPPORT
+	if (fpu->has_avx () && fpu->has_fma ()) {
+		KernelSet const ks = {
+			"avx+fma",
+			x86_sse_avx_compute_peak,
+			x86_sse_avx_find_peaks,
+			x86_sse_avx_apply_gain_to_buffer,
+			x86_fma_mix_buffers_with_gain,
+			x86_sse_avx_mix_buffers_no_gain,
+			x86_sse_avx_copy_vector
+		};
+		k.push_back (ks);
+	}
+#endif
+
+#elif defined ARM_NEON_SUPPORT
+	if (fpu->has_neon ()) {
+		KernelSet const ks = {
+			"neon",
+			arm_neon_compute_peak,
+			arm_neon_find_peaks,
+			arm_neon_apply_gain_to_buffer,
+			arm_neon_mix_buffers_with_gain,
+			arm_neon_mix_buffers_no_gain,
+			arm_neon_copy_vector
+		};
+		k.push_back (ks);
+	}
+
+#elif defined(__APPLE__) && defined(BUILD_VECLIB_OPTIMIZATIONS)
+	if (floor (kCFCoreFoundationVersionNumber) > kCFCoreFoundationVersionNumber10_4) {
+		KernelSet const ks = {
+			"veclib",
+			veclib_compute_peak,
+			veclib_find_peaks,
+			veclib_apply_gain_to_buffer,
+			veclib_mix_buffers_with_gain,
+			veclib_mix_buffers_no_gain,
+			default_copy_vector
+		};
+		k.push_back (ks);
+	}
+#endif
+	(void) fpu;
+}
+
+static void
+fill (float* buf, uint32_t n, uint32_t seed)
+{
+	for (uint32_t i = 0; i < n; ++i) {
+		seed = seed * 1664525 + 1013904223;
+		buf[i] = (seed / 4294967296.f) * 2.f - 1.f;
+	}
+}
+
+static void
+check (bool ok, const char* variant, const char* kernel, uint32_t size, uint32_t align)
+{
+	if (!ok) {
+		printf ("FAIL: %s %s differs from default (size: %u, offset: %u)\n", variant, kernel, size, align);
+		validation_failed = true;
+	}
+}
+
+static bool
+equal_buffers (float const* a, float const* b, uint32_t n)
+{
+	for (uint32_t i = 0; i < n; ++i) {
+		/* fused multiply-add rounds differently */
+		if (fabsf (a[i] - b[i]) > 1e-6f * std::max (1.f, fabsf (b[i]))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void
+validate (KernelSet const& ref, KernelSet const& k)
+{
+	for (uint32_t size = 1; size <= 1024; size = size < 64 ? size + 1 : size * 2) {
+		for (uint32_t a = 0; a < max_align; ++a) {
+			float* const src = src_buf + a;
+			float* const dst = dst_buf + a;
+			float* const cmp = ref_buf + a;
+
+			fill (src, size, size + a);
+
+			float const pk_ref = ref.compute_peak (src, size, 0.f);
+			float const pk     = k.compute_peak (src, size, 0.f);
+			check (fabsf (pk - pk_ref) < 1e-6f, k.name, "compute_peak", size, a);
+
+			float min_ref = src[0], max_ref = src[0];
+			float min_k   = src[0], max_k   = src[0];
+			ref.find_peaks (src, size, &min_ref, &max_ref);
+			k.find_peaks (src, size, &min_k, &max_k);
+			check (fabsf (min_k - min_ref) < 2e-6f && fabsf (max_k - max_ref) < 2e-6f, k.name, "find_peaks", size, a);
+
+			fill (dst, size, size * 3 + a);
+			memcpy (cmp, dst, size * sizeof (float));
+			ref.apply_gain_to_buffer (cmp, size, 0.7f);
+			k.apply_gain_to_buffer (dst, size, 0.7f);
+			check (equal_buffers (dst, cmp, size), k.name, "apply_gain_to_buffer", size, a);
+
+			ref.mix_buffers_with_gain (cmp, src, size, 0.45f);
+			k.mix_buffers_with_gain (dst, src, size, 0.45f);
+			check (equal_buffers (dst, cmp, size), k.name, "mix_buffers_with_gain", size, a);
+
+			ref.mix_buffers_no_gain (cmp, src, size);
+			k.mix_buffers_no_gain (dst, src, size);
+			check (equal_buffers (dst, cmp, size), k.name, "mix_buffers_no_gain", size, a);
+
+			ref.copy_vector (cmp, src, size);
+			k.copy_vector (dst, src, size);
+			check (!memcmp (dst, cmp, size * sizeof (float)), k.name, "copy_vector", size, a);
+		}
+	}
+}
+
+enum Kernel {
+	ComputePeak,
+	FindPeaks,
+	ApplyGain,
+	MixWithGain,
+	MixNoGain,
+	CopyVector
+};
+
+static const char* kernel_names[] = {
+	"compute_peak",
+	"find_peaks",
+	"apply_gain_to_buffer",
+	"mix_buffers_with_gain",
+	"mix_buffers_no_gain",
+	"copy_vector"
+};
+
+static void
+run_kernel (KernelSet const& k, Kernel kernel, float* dst, float const* src, uint32_t size)
+{
+	static volatile float sink;
+
+	switch (kernel) {
+		case ComputePeak:
+			sink = k.compute_peak (src, size, 0.f);
+			break;
+		case FindPeaks:
+			{
+				float min = src[0];
+				float max = src[0];
+				k.find_peaks (src, size, &min, &max);
+				sink = max - min;
+			}
+			break;
+		case ApplyGain:
+			/* unity gain, to not overflow or denormalize the buffer */
+			k.apply_gain_to_buffer (dst, size, 1.f);
+			break;
+		case MixWithGain:
+			k.mix_buffers_with_gain (dst, src, size, 1e-12f);
+			break;
+		case MixNoGain:
+			k.mix_buffers_no_gain (dst, src, size);
+			break;
+		case CopyVector:
+			k.copy_vector (dst, src, size);
+			break;
+	}
+}
+
+/** @return throughput in samples/ns */
+static double
+benchmark (KernelSet const& k, Kernel kernel, uint32_t size, uint32_t align)
+{
+	float* const src = src_buf + align;
+	float* const dst = dst_buf + align;
+
+	fill (src, size, 1);
+	memset (dst, 0, size * sizeof (float));
+
+	/* warm up the cache, and estimate a suitable number of iterations */
+	uint64_t iter = 16;
+	Timing t;
+	while (true) {
+		t.start ();
+		for (uint64_t i = 0; i < iter; ++i) {
+			run_kernel (k, kernel, dst, src, size);
+		}
+		t.update ();
+		if (t.elapsed () > 1000 || iter > ((uint64_t)1 << 40)) {
+			break;
+		}
+		iter *= 4;
+	}
+
+	iter = std::max<uint64_t> (1, iter * min_duration / std::max<uint64_t> (1, t.elapsed ()));
+
+	/* best of three */
+	uint64_t best = 0;
+	for (int run = 0; run < 3; ++run) {
+		t.start ();
+		for (uint64_t i = 0; i < iter; ++i) {
+			run_kernel (k, kernel, dst, src, size);
+		}
+		t.update ();
+		if (run == 0 || t.elapsed () < best) {
+			best = t.elapsed ();
+		}
+	}
+
+	return (double) (iter * size) / (std::max<uint64_t> (1, best) * 1000.0);
+}
+
+static void
+usage (const char* argv0)
+{
+	fprintf (stderr, "Usage: %s [-t <msec per measurement>] [-k <kernel>]\n", argv0);
+	fprintf (stderr, "  kernels: ");
+	for (size_t i = 0; i < sizeof (kernel_names) / sizeof (kernel_names[0]); ++i) {
+		fprintf (stderr, "%s ", kernel_names[i]);
+	}
+	fprintf (stderr, "\n");
+	exit (EXIT_FAILURE);
+}
+
+int
+main (int argc, char* argv[])
+{
+	std::string only;
+
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp (argv[i], "-t") && i + 1 < argc) {
+			min_duration = atoi (argv[++i]) * 1000;
+		} else if (!strcmp (argv[i], "-k") && i + 1 < argc) {
+			only = argv[++i];
+		} else {
+			usage (argv[0]);
+		}
+	}
+
+	if (min_duration <= 0) {
+		usage (argv[0]);
+	}
+
+	cache_aligned_malloc ((void**) &src_buf, sizeof (float) * (max_size + max_align));
+	cache_aligned_malloc ((void**) &dst_buf, sizeof (float) * (max_size + max_align));
+	cache_aligned_malloc ((void**) &ref_buf, sizeof (float) * (max_size + max_align));
+
+	vector<KernelSet> kernels;
+	available_kernels (kernels);
+
+	/* numerical equivalence */
+	for (vector<KernelSet>::const_iterator k = kernels.begin (); k != kernels.end (); ++k) {
+		validate (kernels.front (), *k);
+	}
+
+	printf ("# %-22s %-8s %6s %6s %12s\n", "kernel", "variant", "size", "offset", "samples/ns");
+
+	for (size_t n = 0; n < sizeof (kernel_names) / sizeof (kernel_names[0]); ++n) {
+		if (!only.empty () && only != kernel_names[n]) {
+			continue;
+		}
+		for (uint32_t size = 32; size <= max_size; size *= 2) {
+			/* aligned, 16 byte and 4 byte offset */
+			static const uint32_t offsets[] = { 0, 4, 1 };
+			for (size_t o = 0; o < sizeof (offsets) / sizeof (offsets[0]); ++o) {
+				for (vector<KernelSet>::const_iterator k = kernels.begin (); k != kernels.end (); ++k) {
+					double const rate = benchmark (*k, (Kernel) n, size, offsets[o]);
+					printf ("  %-22s %-8s %6u %6u %12.3f\n", kernel_names[n], k->name, size, offsets[o], rate);
+					fflush (stdout);
+				}
+			}
+		}
+	}
+
+	cache_aligned_free (src_buf);
+	cache_aligned_free (dst_buf);
+	cache_aligned_free (ref_buf);
+
+	if (validation_failed) {
+		printf ("ERROR: some kernels do not match the default implementation\n");
+		return EXIT_FAILURE;
+	}
+
+	return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <boost/bind.hpp>
+
+#include <glibmm/timer.h>
+
+#include "ardour/rt_tasklist.h"
+#include "ardour/session.h"
+
+#include "rt_tasklist_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (RTTaskListTest);
+
+using namespace ARDOUR;
+
+void
+RTTaskListTest::Counter::run_task (uint32_t i)
+{
+	/* vary the duration, so that items are still in progress
+	 * when the calling thread runs out of queued items */
+	if (i % 3) {
+		Glib::usleep (50 * (i % 3));
+	}
+	g_atomic_int_inc (&counts[i]);
+}
+
+void
+RTTaskListTest::completionTest ()
+{
+	boost::shared_ptr<RTTaskList> tl = _session->rt_tasklist ();
+	CPPUNIT_ASSERT (tl);
+
+	Counter          c (32);
+	std::vector<int> expected (32, 0);
+
+	/* every item must have completed when process () returns,
+	 * also when the same list is used again right away */
+	for (int round = 0; round < 200; ++round) {
+		uint32_t const n = round % 33;
+		tl->process (c, n);
+		for (uint32_t i = 0; i < 32; ++i) {
+			if (i < n) {
+				++expected[i];
+			}
+			CPPUNIT_ASSERT_EQUAL (expected[i], (int)g_atomic_int_get (&c.counts[i]));
+		}
+	}
+}
+
+static void
+increment (gint* cnt, int i)
+{
+	if (i % 2) {
+		Glib::usleep (100);
+	}
+	g_atomic_int_inc (cnt);
+}
+
+void
+RTTaskListTest::functorTest ()
+{
+	boost::shared_ptr<RTTaskList> tl = _session->rt_tasklist ();
+	CPPUNIT_ASSERT (tl);
+
+	gint cnt = 0;
+
+	RTTaskList::TaskList tasks;
+	for (int i = 0; i < 16; ++i) {
+		tasks.push_back (boost::bind (&increment, &cnt, i));
+	}
+
+	for (int round = 1; round <= 50; ++round) {
+		tl->process (tasks);
+		CPPUNIT_ASSERT_EQUAL (16 * round, (int)g_atomic_int_get (&cnt));
+	}
+}
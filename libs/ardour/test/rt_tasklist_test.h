@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <vector>
+
+#include <glib.h>
+
+#include "ardour/graphnode.h"
+#include "test_needing_session.h"
+
+class RTTaskListTest : public TestNeedingSession
+{
+	CPPUNIT_TEST_SUITE (RTTaskListTest);
+	CPPUNIT_TEST (completionTest);
+	CPPUNIT_TEST (functorTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void completionTest ();
+	void functorTest ();
+
+private:
+	/** Counts how often each item was processed */
+	class Counter : public ARDOUR::GraphTaskList
+	{
+	public:
+		Counter (uint32_t n) : counts (n, 0) {}
+
+		void run_task (uint32_t);
+
+		std::vector<gint> counts;
+	};
+};
@@ -635,3 +635,63 @@ TempoTest::tempoFundamentalsTest ()
 	CPPUNIT_ASSERT_DOUBLES_EQUAL (164.0, tE->quarter_notes_per_minute (), 1e-17);
 	CPPUNIT_ASSERT_DOUBLES_EQUAL (41.0, tE->pulses_per_minute (), 1e-17);
 }
+
+void
+TempoTest::metricIndexTest ()
+{
+	int const sampling_rate = 48000;
+
+	TempoMap map (sampling_rate);
+	Meter meterA (4, 4);
+	map.replace_meter (map.first_meter(), meterA, BBT_Time (1, 1, 0), 0, AudioTime);
+	Tempo tempoA (120.0, 4.0);
+	map.replace_tempo (map.first_tempo(), tempoA, 0.0, 0, AudioTime);
+
+	/* a tempo change every bar, a meter change every 8 bars */
+	for (int n = 1; n < 128; ++n) {
+		Tempo t (90.0 + (n % 7) * 10.0, 4.0);
+		map.add_tempo (t, n, 0, MusicTime);
+	}
+	for (int n = 1; n < 16; ++n) {
+		Meter m (3 + (n % 2), 4);
+		map.add_meter (m, BBT_Time (1 + n * 8, 1, 0), 0, MusicTime);
+	}
+
+	CPPUNIT_ASSERT (map._index.valid);
+
+	/* lookups on a copy of the metrics walk the list */
+	Metrics const copy (map._metrics);
+	CPPUNIT_ASSERT (!map.use_index (copy));
+
+	for (double x = -1.0; x < 100.0; x += 0.37) {
+		CPPUNIT_ASSERT_EQUAL (&map.tempo_section_at_minute_locked (copy, x / 10.0), &map.tempo_section_at_minute_locked (map._metrics, x / 10.0));
+		CPPUNIT_ASSERT_EQUAL (&map.meter_section_at_minute_locked (copy, x / 10.0), &map.meter_section_at_minute_locked (map._metrics, x / 10.0));
+		CPPUNIT_ASSERT_EQUAL (&map.meter_section_at_beat_locked (copy, x * 5.0), &map.meter_section_at_beat_locked (map._metrics, x * 5.0));
+
+		CPPUNIT_ASSERT_EQUAL (map.beat_at_minute_locked (copy, x / 10.0), map.beat_at_minute_locked (map._metrics, x / 10.0));
+		CPPUNIT_ASSERT_EQUAL (map.minute_at_beat_locked (copy, x * 5.0), map.minute_at_beat_locked (map._metrics, x * 5.0));
+		CPPUNIT_ASSERT_EQUAL (map.pulse_at_minute_locked (copy, x / 10.0), map.pulse_at_minute_locked (map._metrics, x / 10.0));
+		CPPUNIT_ASSERT_EQUAL (map.minute_at_pulse_locked (copy, x), map.minute_at_pulse_locked (map._metrics, x));
+		CPPUNIT_ASSERT_EQUAL (map.beat_at_pulse_locked (copy, x), map.beat_at_pulse_locked (map._metrics, x));
+
+		BBT_Time const bbt = map.bbt_at_minute_locked (copy, x / 10.0);
+		CPPUNIT_ASSERT (bbt == map.bbt_at_minute_locked (map._metrics, x / 10.0));
+		CPPUNIT_ASSERT_EQUAL (map.minute_at_bbt_locked (copy, bbt), map.minute_at_bbt_locked (map._metrics, bbt));
+	}
+
+	for (samplepos_t s = 0; s < 120 * sampling_rate; s += 12345) {
+		TempoMetric const m (map.metric_at (s));
+		Metrics::const_iterator last;
+		TempoMetric const l (map.metric_at (s, &last));
+		CPPUNIT_ASSERT_EQUAL (&l.tempo (), &m.tempo ());
+		CPPUNIT_ASSERT_EQUAL (&l.meter (), &m.meter ());
+		CPPUNIT_ASSERT_EQUAL (l.minute (), m.minute ());
+	}
+
+	/* changes invalidate and re-build the index */
+	const size_t n_tempi = map._index.tempi.size ();
+	map.remove_tempo (map.tempo_section_at_sample (60 * sampling_rate), true);
+	CPPUNIT_ASSERT (map._index.valid);
+	CPPUNIT_ASSERT_EQUAL (n_tempi - 1, map._index.tempi.size ());
+	CPPUNIT_ASSERT_EQUAL (map._metrics.size (), map._index.sections.size ());
+}
@@ -553,6 +553,19 @@ Vst3ParamValueQueue::addPoint (int32 sampleOffset, Vst::ParamValue value, int32&
 		}
 	}
 
+	if (_values.size () >= maxNumPoints) {
+		/* do not re-allocate in the process thread. Points in between
+		 * can be dropped, but the latest one sets the value that the
+		 * parameter has at the end of the cycle, and must be kept.
+		 */
+		if (dest_index < (int32)_values.size ()) {
+			return kResultFalse;
+		}
+		_values.back () = Value (value, sampleOffset);
+		index           = _values.size () - 1;
+		return kResultTrue;
+	}
+
 	Value v (value, sampleOffset);
 	if (dest_index == (int32)_values.size ()) {
 		_values.push_back (v);
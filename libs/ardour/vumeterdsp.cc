@@ -18,12 +18,17 @@
  */
 
 #include <math.h>
+
 #include "ardour/vumeterdsp.h"
+#include "ardour/mix.h"
+#include "ardour/runtime_functions.h"
 
 
 float Vumeterdsp::_w;
 float Vumeterdsp::_g;
 
+static const uint32_t max_batch = 32; // channels per kernel call
+
 
 Vumeterdsp::Vumeterdsp (void) :
     _z1 (0),
@@ -39,31 +44,17 @@ Vumeterdsp::~Vumeterdsp (void)
 }
 
 
-void Vumeterdsp::process (float const *p, int n)
+void Vumeterdsp::load_state (float& z1, float& z2, float& m)
 {
-    float z1, z2, m, t1, t2;
-
     z1 = _z1 > 20 ? 20 : (_z1 < -20 ? -20 : _z1);
     z2 = _z2 > 20 ? 20 : (_z2 < -20 ? -20 : _z2);
     m = _res ? 0: _m;
     _res = false;
+}
 
-    n /= 4;
-    while (n--)
-    {
-	t2 = z2 / 2;
-	t1 = fabsf (*p++) - t2;
-	z1 += _w * (t1 - z1);
-	t1 = fabsf (*p++) - t2;
-	z1 += _w * (t1 - z1);
-	t1 = fabsf (*p++) - t2;
-	z1 += _w * (t1 - z1);
-	t1 = fabsf (*p++) - t2;
-	z1 += _w * (t1 - z1);
-	z2 += 4 * _w * (z1 - z2);
-	if (z2 > m) m = z2;
-    }
 
+void Vumeterdsp::store_state (float z1, float z2, float m)
+{
     if (isnan(z1)) z1 = 0;
     if (isnan(z2)) z2 = 0;
     _z1 = z1;
@@ -72,6 +63,37 @@ void Vumeterdsp::process (float const *p, int n)
 }
 
 
+void Vumeterdsp::process (float const *p, int n)
+{
+    float z1, z2, m;
+
+    load_state (z1, z2, m);
+    default_vumeter_process (&p, 1, n, _w, &z1, &z2, &m);
+    store_state (z1, z2, m);
+}
+
+
+void Vumeterdsp::process (Vumeterdsp* const* vu, float const* const* p, uint32_t n_chn, int n)
+{
+    float z1[max_batch];
+    float z2[max_batch];
+    float m[max_batch];
+
+    while (n_chn > 0)
+    {
+	const uint32_t n_batch = n_chn < max_batch ? n_chn : max_batch;
+
+	for (uint32_t c = 0; c < n_batch; ++c) vu[c]->load_state (z1[c], z2[c], m[c]);
+	ARDOUR::vumeter_process (p, n_batch, n, _w, z1, z2, m);
+	for (uint32_t c = 0; c < n_batch; ++c) vu[c]->store_state (z1[c], z2[c], m[c]);
+
+	vu    += n_batch;
+	p     += n_batch;
+	n_chn -= n_batch;
+    }
+}
+
+
 float Vumeterdsp::read (void)
 {
     _res = true;
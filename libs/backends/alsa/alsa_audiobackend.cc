@@ -1613,11 +1613,9 @@ AlsaAudioBackend::midi_event_get (
 	if (event_index >= source.size ()) {
 		return -1;
 	}
-	AlsaMidiEvent const& event = source[event_index];
-
-	timestamp = event.timestamp ();
-	size = event.size ();
-	*buf = event.data ();
+	timestamp = source.timestamp (event_index);
+	size = source.event_size (event_index);
+	*buf = source.data (event_index);
 	return 0;
 }
 
@@ -1633,13 +1631,15 @@ AlsaAudioBackend::midi_event_put (
 	}
 	AlsaMidiBuffer& dst = * static_cast<AlsaMidiBuffer*>(port_buffer);
 #ifndef NDEBUG
-	if (dst.size () && (pframes_t)dst.back ().timestamp () > timestamp) {
-		// nevermind, ::get_buffer() sorts events
+	if (dst.size () && dst.timestamp (dst.size () - 1) > timestamp) {
+		// nevermind, the buffer sorts events
 		fprintf (stderr, "AlsaMidiBuffer: it's too late for this event. %d > %d\n",
-				(pframes_t)dst.back ().timestamp (), timestamp);
+				dst.timestamp (dst.size () - 1), timestamp);
 	}
 #endif
-	dst.push_back (AlsaMidiEvent (timestamp, buffer, size));
+	if (!dst.push_back (timestamp, buffer, size)) {
+		return -1;
+	}
 	return 0;
 }
 
@@ -1750,9 +1750,9 @@ AlsaAudioBackend::port_factory (std::string const & name, ARDOUR::DataType type,
 void*
 AlsaAudioBackend::get_buffer (PortEngine::PortHandle port_handle, pframes_t nframes)
 {
-	BackendPortPtr port = boost::dynamic_pointer_cast<BackendPort> (port_handle);
+	BackendPort* port = static_cast<BackendPort*> (port_handle.get ());
 	assert (port);
-	assert (valid_port (port));
+	assert (valid_port (boost::dynamic_pointer_cast<BackendPort> (port_handle)));
 	return port->get_buffer (nframes);
 }
 
@@ -1917,10 +1917,6 @@ AlsaAudioBackend::main_process_thread ()
 				}
 				pthread_mutex_unlock (&_device_port_mutex);
 
-				for (std::vector<BackendPortPtr>::const_iterator it = _system_outputs.begin (); it != _system_outputs.end (); ++it) {
-					memset ((*it)->get_buffer (_samples_per_period), 0, _samples_per_period * sizeof (Sample));
-				}
-
 				/* call engine process callback */
 				_last_process_start = g_get_monotonic_time();
 				if (engine.process_callback (_samples_per_period)) {
@@ -1942,8 +1938,8 @@ AlsaAudioBackend::main_process_thread ()
 					AlsaMidiBuffer const * src = boost::dynamic_pointer_cast<const AlsaMidiPort>(*it)->const_buffer();
 					AlsaMidiOut *rm = _rmidi_out.at(i);
 					rm->sync_time (clock1);
-					for (AlsaMidiBuffer::const_iterator mit = src->begin (); mit != src->end (); ++mit) {
-						rm->send_event (mit->timestamp (), mit->data (), mit->size ());
+					for (size_t e = 0; e < src->size (); ++e) {
+						rm->send_event (src->timestamp (e), src->data (e), src->event_size (e));
 					}
 				}
 				pthread_mutex_unlock (&_device_port_mutex);
@@ -2271,24 +2267,7 @@ void*
 AlsaAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
-			memset (_buffer, 0, n_samples * sizeof (Sample));
-		} else {
-			boost::shared_ptr<const AlsaAudioPort> source = boost::dynamic_pointer_cast<const AlsaAudioPort>(*it);
-			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = boost::dynamic_pointer_cast<const AlsaAudioPort>(*it);
-				assert (source && source->is_output ());
-				Sample* dst = buffer ();
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
-			}
-		}
+		return mix_connections (_buffer, n_samples);
 	}
 	return _buffer;
 }
@@ -2299,62 +2278,20 @@ AlsaMidiPort::AlsaMidiPort (AlsaAudioBackend &b, const std::string& name, PortFl
 	, _n_periods (1)
 	, _bufperiod (0)
 {
-	_buffer[0].clear ();
-	_buffer[1].clear ();
-	_buffer[2].clear ();
-
-	_buffer[0].reserve(256);
-	_buffer[1].reserve(256);
-	_buffer[2].reserve(256);
 }
 
 AlsaMidiPort::~AlsaMidiPort ()
 {
 }
 
-struct MidiEventSorter {
-	bool operator() (AlsaMidiEvent const& a, AlsaMidiEvent const& b) {
-		return a < b;
-	}
-};
-
-void* AlsaMidiPort::get_buffer (pframes_t /* nframes */)
+void* AlsaMidiPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		(_buffer[_bufperiod]).clear ();
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		for (std::set<BackendPortPtr>::const_iterator i = connections.begin ();
-				i != connections.end ();
-				++i) {
-			const AlsaMidiBuffer * src = boost::dynamic_pointer_cast<const AlsaMidiPort>(*i)->const_buffer ();
-			for (AlsaMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
-				(_buffer[_bufperiod]).push_back (*it);
-			}
-		}
-		std::stable_sort ((_buffer[_bufperiod]).begin (), (_buffer[_bufperiod]).end (), MidiEventSorter());
+		merge_connections (_buffer[_bufperiod], n_samples);
 	}
 	return &(_buffer[_bufperiod]);
 }
 
-AlsaMidiEvent::AlsaMidiEvent (const pframes_t timestamp, const uint8_t* data, size_t size)
-	: _size (size)
-	, _timestamp (timestamp)
-{
-	if (size > 0 && size < MaxAlsaMidiEventSize) {
-		memcpy (_data, data, size);
-	}
-}
-
-AlsaMidiEvent::AlsaMidiEvent (const AlsaMidiEvent& other)
-	: _size (other.size ())
-	, _timestamp (other.timestamp ())
-{
-	if (other._size > 0) {
-		assert (other._size < MaxAlsaMidiEventSize);
-		memcpy (_data, other._data, other._size);
-	}
-};
-
 /******************************************************************************/
 
 AlsaDeviceReservation::AlsaDeviceReservation ()
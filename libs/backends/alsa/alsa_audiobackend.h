@@ -50,21 +50,7 @@ namespace ARDOUR {
 
 class AlsaAudioBackend;
 
-class AlsaMidiEvent {
-	public:
-		AlsaMidiEvent (const pframes_t timestamp, const uint8_t* data, size_t size);
-		AlsaMidiEvent (const AlsaMidiEvent& other);
-		size_t size () const { return _size; };
-		pframes_t timestamp () const { return _timestamp; };
-		const uint8_t* data () const { return _data; };
-		bool operator< (const AlsaMidiEvent &other) const { return timestamp () < other.timestamp (); };
-	private:
-		size_t _size;
-		pframes_t _timestamp;
-		uint8_t _data[MaxAlsaMidiEventSize];
-};
-
-typedef std::vector<AlsaMidiEvent> AlsaMidiBuffer;
+typedef BackendMidiBuffer AlsaMidiBuffer;
 
 class AlsaAudioPort : public BackendPort {
 	public:
@@ -1216,10 +1216,9 @@ CoreAudioBackend::get_latency_range (PortEngine::PortHandle port_handle, bool fo
 void*
 CoreAudioBackend::get_buffer (PortEngine::PortHandle port_handle, pframes_t nframes)
 {
-	boost::shared_ptr<BackendPort> port = boost::dynamic_pointer_cast<BackendPort> (port_handle);
+	BackendPort* port = static_cast<BackendPort*> (port_handle.get ());
 	assert (port);
-	assert (valid_port (port));
-	if (!port || !valid_port (port)) return NULL; // XXX remove me
+	assert (valid_port (boost::dynamic_pointer_cast<BackendPort> (port_handle)));
 	return port->get_buffer (nframes);
 }
 
@@ -1434,11 +1433,6 @@ CoreAudioBackend::process_callback (const uint32_t n_samples, const uint64_t hos
 		_pcmio->get_capture_channel (i, (float*)(*it)->get_buffer(n_samples), n_samples);
 	}
 
-	/* clear output buffers */
-	for (std::vector<BackendPortPtr>::const_iterator it = _system_outputs.begin (); it != _system_outputs.end (); ++it) {
-		memset ((*it)->get_buffer (n_samples), 0, n_samples * sizeof (Sample));
-	}
-
 	_midiio->start_cycle();
 	_last_process_start = host_time;
 
@@ -1611,24 +1605,7 @@ void*
 CoreAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
-			memset (_buffer, 0, n_samples * sizeof (Sample));
-		} else {
-			boost::shared_ptr<const CoreAudioPort> source = boost::dynamic_pointer_cast<const CoreAudioPort>(*it);
-			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = boost::dynamic_pointer_cast<const CoreAudioPort>(*it);
-				assert (source && source->is_output ());
-				Sample* dst = buffer ();
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
-			}
-		}
+		return mix_connections (_buffer, n_samples);
 	}
 	return _buffer;
 }
@@ -1665,11 +1642,9 @@ void* CoreMidiPort::get_buffer (pframes_t /* nframes */)
 {
 	if (is_input ()) {
 		(_buffer[_bufperiod]).clear ();
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		for (std::set<BackendPortPtr>::const_iterator i = connections.begin ();
-		     i != connections.end ();
-		     ++i) {
-			const CoreMidiBuffer * src = boost::dynamic_pointer_cast<const CoreMidiPort>(*i)->const_buffer ();
+		boost::shared_ptr<ConnectionList> cl = connection_list ();
+		for (ConnectionList::const_iterator i = cl->begin (); i != cl->end (); ++i) {
+			const CoreMidiBuffer * src = static_cast<const CoreMidiPort*>(*i)->const_buffer ();
 			for (CoreMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
 				(_buffer[_bufperiod]).push_back (*it);
 			}
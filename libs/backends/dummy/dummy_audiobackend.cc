@@ -791,11 +791,9 @@ DummyAudioBackend::midi_event_get (
 	if (event_index >= source.size ()) {
 		return -1;
 	}
-	DummyMidiEvent * const event = source[event_index].get ();
-
-	timestamp = event->timestamp ();
-	size = event->size ();
-	*buf = event->data ();
+	timestamp = source.timestamp (event_index);
+	size = source.event_size (event_index);
+	*buf = source.data (event_index);
 	return 0;
 }
 
@@ -807,11 +805,13 @@ DummyAudioBackend::midi_event_put (
 {
 	assert (buffer && port_buffer);
 	DummyMidiBuffer& dst = * static_cast<DummyMidiBuffer*>(port_buffer);
-	if (dst.size () && (pframes_t)dst.back ()->timestamp () > timestamp) {
-		// nevermind, ::get_buffer() sorts events, but always print warning
-		fprintf (stderr, "DummyMidiBuffer: it's too late for this event %d > %d.\n", (pframes_t)dst.back ()->timestamp (), timestamp);
+	if (dst.size () && dst.timestamp (dst.size () - 1) > timestamp) {
+		// nevermind, the buffer sorts events, but always print warning
+		fprintf (stderr, "DummyMidiBuffer: it's too late for this event %d > %d.\n", dst.timestamp (dst.size () - 1), timestamp);
+	}
+	if (!dst.push_back (timestamp, buffer, size)) {
+		return -1;
 	}
-	dst.push_back (boost::shared_ptr<DummyMidiEvent>(new DummyMidiEvent (timestamp, buffer, size)));
 #if 0 // DEBUG MIDI EVENTS
 	printf("DummyAudioBackend::midi_event_put %d, %zu: ", timestamp, size);
 	for (size_t xx = 0; xx < size; ++xx) {
@@ -913,9 +913,9 @@ DummyAudioBackend::get_latency_range (PortEngine::PortHandle port_handle, bool f
 void*
 DummyAudioBackend::get_buffer (PortEngine::PortHandle port_handle, pframes_t nframes)
 {
-	BackendPortPtr port = boost::dynamic_pointer_cast<BackendPort> (port_handle);
+	BackendPort* port = static_cast<BackendPort*> (port_handle.get ());
 	assert (port);
-	assert (valid_port (port));
+	assert (valid_port (boost::dynamic_pointer_cast<BackendPort> (port_handle)));
 	return port->get_buffer (nframes);
 }
 
@@ -1381,13 +1381,13 @@ void DummyAudioPort::midi_to_wavetable (DummyMidiBuffer const * const src, size_
 	 * to verify layency-compensation alignment
 	 * (here: midi-out playback-latency + audio-in capture-latency)
 	 */
-	for (DummyMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
-		const pframes_t t = (*it)->timestamp();
+	for (size_t i = 0; i < src->size (); ++i) {
+		const pframes_t t = src->timestamp (i);
 		assert(t < n_samples);
 		// somewhat arbitrary mapping for quick visual feedback
 		float v = -.5f;
-		if ((*it)->size() == 3) {
-			const unsigned char *d = (*it)->const_data();
+		if (src->event_size (i) == 3) {
+			const unsigned char *d = src->data (i);
 			if ((d[0] & 0xf0) == 0x90) { // note on
 				v = .25f + d[2] / 512.f;
 			}
@@ -1612,30 +1612,8 @@ void*
 DummyAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
-			memset (_buffer, 0, n_samples * sizeof (Sample));
-		} else {
-			boost::shared_ptr<DummyAudioPort> source = boost::dynamic_pointer_cast<DummyAudioPort>(*it);
-			assert (source && source->is_output ());
-			if (source->is_physical() && source->is_terminal()) {
-				source->get_buffer(n_samples); // generate signal.
-			}
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = boost::dynamic_pointer_cast<DummyAudioPort>(*it);
-				assert (source && source->is_output ());
-				Sample* dst = buffer ();
-				if (source->is_physical() && source->is_terminal()) {
-					source->get_buffer(n_samples); // generate signal.
-				}
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
-			}
-		}
+		/* this also generates the signal of connected physical terminal ports */
+		return mix_connections (_buffer, n_samples);
 	} else if (is_output () && is_physical () && is_terminal()) {
 		if (!_gen_cycle) {
 			generate(n_samples);
@@ -1661,18 +1639,9 @@ DummyMidiPort::~DummyMidiPort () {
 	_loopback.clear ();
 }
 
-struct MidiEventSorter {
-	bool operator() (const boost::shared_ptr<DummyMidiEvent>& a, const boost::shared_ptr<DummyMidiEvent>& b) {
-		return *a < *b;
-	}
-};
-
 void DummyMidiPort::set_loopback (DummyMidiBuffer const * const src)
 {
-	_loopback.clear ();
-	for (DummyMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
-		_loopback.push_back (boost::shared_ptr<DummyMidiEvent>(new DummyMidiEvent (**it)));
-	}
+	_loopback.copy (*src);
 }
 
 std::string
@@ -1720,18 +1689,16 @@ void DummyMidiPort::midi_generate (const pframes_t n_samples)
 		pframes_t pp = pulse_position ();
 		if (pp < n_samples - 1) {
 			uint8_t md[3] = {0x90, 0x3c, 0x7f};
-			_buffer.push_back (boost::shared_ptr<DummyMidiEvent>(new DummyMidiEvent (pp, md, 3)));
+			_buffer.push_back (pp, md, 3);
 			md[0] = 0x80;
 			md[2] = 0;
-			_buffer.push_back (boost::shared_ptr<DummyMidiEvent>(new DummyMidiEvent (pp + 1, md, 3)));
+			_buffer.push_back (pp + 1, md, 3);
 		}
 		return;
 	}
 
 	if (_midi_seq_spb == 0 || !_midi_seq_dat) {
-		for (DummyMidiBuffer::const_iterator it = _loopback.begin (); it != _loopback.end (); ++it) {
-			_buffer.push_back (boost::shared_ptr<DummyMidiEvent>(new DummyMidiEvent (**it)));
-		}
+		_buffer.copy (_loopback);
 		return;
 	}
 
@@ -1763,7 +1730,7 @@ void DummyMidiPort::midi_generate (const pframes_t n_samples)
 					case 6: buf[1] =  0x60 |  ((/* 25fps*/ 0x20 | hour) & 0x0f); break;
 					case 7: buf[1] =  0x70 | (((/* 25fps*/ 0x20 | hour) & 0xf0)>>4); break;
 				}
-				_buffer.push_back (boost::shared_ptr<DummyMidiEvent>(new DummyMidiEvent (tc_sample - _midi_seq_time, buf, 2)));
+				_buffer.push_back (tc_sample - _midi_seq_time, buf, 2);
 			}
 			tc_sample += audio_samples_per_qf;
 			if (++qf == 8) {
@@ -1789,7 +1756,7 @@ void DummyMidiPort::midi_generate (const pframes_t n_samples)
 			buf[0] = 0xf2;
 			buf[1] = bcnt & 0x7f; // LSB
 			buf[2] = (bcnt >> 7) & 0x7f; // MSB
-			_buffer.push_back (boost::shared_ptr<DummyMidiEvent>(new DummyMidiEvent (0, buf, 3)));
+			_buffer.push_back (0, buf, 3);
 		}
 
 		/* MIDI System Real-Time Messages */
@@ -1801,7 +1768,7 @@ void DummyMidiPort::midi_generate (const pframes_t n_samples)
 		if (_midi_seq_time == 0) {
 			/* start */
 			buf[0] = MIDI_RT_START;
-			_buffer.push_back (boost::shared_ptr<DummyMidiEvent>(new DummyMidiEvent (0, buf, 1)));
+			_buffer.push_back (0, buf, 1);
 		}
 
 		const int clock_tick_interval = _midi_seq_spb; // samples per clock-tick
@@ -1811,7 +1778,7 @@ void DummyMidiPort::midi_generate (const pframes_t n_samples)
 		while (clk_sample < _midi_seq_time + n_samples) {
 			if (clk_sample >= _midi_seq_time) {
 				buf[0] = MIDI_RT_CLOCK;
-				_buffer.push_back (boost::shared_ptr<DummyMidiEvent>(new DummyMidiEvent (clk_sample - _midi_seq_time, buf, 1)));
+				_buffer.push_back (clk_sample - _midi_seq_time, buf, 1);
 			}
 			clk_sample += clock_tick_interval;
 		}
@@ -1832,11 +1799,9 @@ void DummyMidiPort::midi_generate (const pframes_t n_samples)
 		if ((pframes_t) ev_beat_time >= n_samples) {
 			break;
 		}
-		_buffer.push_back (boost::shared_ptr<DummyMidiEvent>(new DummyMidiEvent (
-						ev_beat_time,
-						_midi_seq_dat[_midi_seq_pos].event,
-						_midi_seq_dat[_midi_seq_pos].size
-						)));
+		_buffer.push_back (ev_beat_time,
+				_midi_seq_dat[_midi_seq_pos].event,
+				_midi_seq_dat[_midi_seq_pos].size);
 		++_midi_seq_pos;
 
 		if (_midi_seq_dat[_midi_seq_pos].event[0] == 0xff && _midi_seq_dat[_midi_seq_pos].event[1] == 0xff) {
@@ -1851,21 +1816,7 @@ void DummyMidiPort::midi_generate (const pframes_t n_samples)
 void* DummyMidiPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		_buffer.clear ();
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		for (std::set<BackendPortPtr>::const_iterator i = connections.begin ();
-				i != connections.end ();
-				++i) {
-			boost::shared_ptr<DummyMidiPort> source = boost::dynamic_pointer_cast<DummyMidiPort>(*i);
-			if (source->is_physical() && source->is_terminal()) {
-				source->get_buffer(n_samples); // generate signal.
-			}
-			const DummyMidiBuffer *src = source->const_buffer ();
-			for (DummyMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
-				_buffer.push_back (boost::shared_ptr<DummyMidiEvent>(new DummyMidiEvent (**it)));
-			}
-		}
-		std::stable_sort (_buffer.begin (), _buffer.end (), MidiEventSorter());
+		merge_connections (_buffer, n_samples);
 	} else if (is_output () && is_physical () && is_terminal()) {
 		if (!_gen_cycle) {
 			midi_generate(n_samples);
@@ -1873,29 +1824,3 @@ void* DummyMidiPort::get_buffer (pframes_t n_samples)
 	}
 	return &_buffer;
 }
-
-DummyMidiEvent::DummyMidiEvent (const pframes_t timestamp, const uint8_t* data, size_t size)
-	: _size (size)
-	, _timestamp (timestamp)
-	, _data (0)
-{
-	if (size > 0) {
-		_data = (uint8_t*) malloc (size);
-		memcpy (_data, data, size);
-	}
-}
-
-DummyMidiEvent::DummyMidiEvent (const DummyMidiEvent& other)
-	: _size (other.size ())
-	, _timestamp (other.timestamp ())
-	, _data (0)
-{
-	if (other.size () && other.const_data ()) {
-		_data = (uint8_t*) malloc (other.size ());
-		memcpy (_data, other.const_data (), other.size ());
-	}
-};
-
-DummyMidiEvent::~DummyMidiEvent () {
-	free (_data);
-};
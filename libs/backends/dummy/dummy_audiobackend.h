@@ -52,23 +52,7 @@ namespace DummyMidiData {
 };
 
 
-class DummyMidiEvent {
-	public:
-		DummyMidiEvent (const pframes_t timestamp, const uint8_t* data, size_t size);
-		DummyMidiEvent (const DummyMidiEvent& other);
-		~DummyMidiEvent ();
-		size_t size () const { return _size; };
-		pframes_t timestamp () const { return _timestamp; };
-		const unsigned char* const_data () const { return _data; };
-		unsigned char* data () { return _data; };
-		bool operator< (const DummyMidiEvent &other) const { return timestamp () < other.timestamp (); };
-	private:
-		size_t _size;
-		pframes_t _timestamp;
-		uint8_t *_data;
-};
-
-typedef std::vector<boost::shared_ptr<DummyMidiEvent> > DummyMidiBuffer;
+typedef BackendMidiBuffer DummyMidiBuffer;
 
 class DummyPort : public BackendPort {
 	protected:
@@ -1440,10 +1440,9 @@ PortAudioBackend::get_latency_range (PortEngine::PortHandle port_handle, bool fo
 void*
 PortAudioBackend::get_buffer (PortEngine::PortHandle port_handle, pframes_t nframes)
 {
-	boost::shared_ptr<BackendPort> port = boost::dynamic_pointer_cast<BackendPort>(port_handle);
+	BackendPort* port = static_cast<BackendPort*> (port_handle.get ());
 	assert (port);
-	assert (valid_port (port));
-	if (!port || !valid_port (port)) return NULL; // XXX remove me
+	assert (valid_port (boost::dynamic_pointer_cast<BackendPort> (port_handle)));
 	return port->get_buffer (nframes);
 }
 
@@ -1549,15 +1548,6 @@ PortAudioBackend::blocking_process_main(const float* interleaved_input_data,
 
 	process_incoming_midi ();
 
-	/* clear output buffers */
-	for (std::vector<BackendPortPtr>::const_iterator it = _system_outputs.begin();
-	     it != _system_outputs.end();
-	     ++it) {
-		memset((*it)->get_buffer(_samples_per_period),
-		       0,
-		       _samples_per_period * sizeof(Sample));
-	}
-
 	_last_cycle_start = _cycle_timer.get_start();
 	_cycle_timer.reset_start(PBD::get_microseconds());
 	_cycle_count++;
@@ -1831,23 +1821,7 @@ PortAudioPort::~PortAudioPort () { }
 void* PortAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		std::set<BackendPortPtr>::const_iterator it = get_connections ().begin ();
-		if (it == get_connections ().end ()) {
-			memset (_buffer, 0, n_samples * sizeof (Sample));
-		} else {
-			boost::shared_ptr<const PortAudioPort> source = boost::dynamic_pointer_cast<const PortAudioPort>(*it);
-			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != get_connections ().end ()) {
-				source = boost::dynamic_pointer_cast<const PortAudioPort>(*it);
-				assert (source && source->is_output ());
-				Sample* dst = buffer ();
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
-			}
-		}
+		return mix_connections (_buffer, n_samples);
 	}
 	return _buffer;
 }
@@ -1877,10 +1851,9 @@ void* PortMidiPort::get_buffer (pframes_t /* nframes */)
 {
 	if (is_input ()) {
 		(_buffer[_bufperiod]).clear ();
-		for (std::set<BackendPortPtr>::const_iterator i = get_connections ().begin ();
-				i != get_connections ().end ();
-				++i) {
-			const PortMidiBuffer * src = boost::dynamic_pointer_cast<const PortMidiPort>(*i)->const_buffer ();
+		boost::shared_ptr<ConnectionList> cl = connection_list ();
+		for (ConnectionList::const_iterator i = cl->begin (); i != cl->end (); ++i) {
+			const PortMidiBuffer * src = static_cast<const PortMidiPort*>(*i)->const_buffer ();
 			for (PortMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
 				(_buffer[_bufperiod]).push_back (*it);
 			}
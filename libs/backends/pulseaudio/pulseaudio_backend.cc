@@ -975,11 +975,9 @@ PulseAudioBackend::get_latency_range (PortEngine::PortHandle port_handle, bool f
 void*
 PulseAudioBackend::get_buffer (PortEngine::PortHandle port_handle, pframes_t nframes)
 {
-	BackendPortPtr port = boost::dynamic_pointer_cast<BackendPort> (port_handle);
-
+	BackendPort* port = static_cast<BackendPort*> (port_handle.get ());
 	assert (port);
-	assert (valid_port (port));
-
+	assert (valid_port (boost::dynamic_pointer_cast<BackendPort> (port_handle)));
 	return port->get_buffer (nframes);
 }
 
@@ -1216,25 +1214,7 @@ void*
 PulseAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>&          connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it          = connections.begin ();
-
-		if (it == connections.end ()) {
-			memset (_buffer, 0, n_samples * sizeof (Sample));
-		} else {
-			boost::shared_ptr<PulseAudioPort> source = boost::dynamic_pointer_cast<PulseAudioPort> (*it);
-			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = boost::dynamic_pointer_cast<PulseAudioPort> (*it);
-				assert (source && source->is_output ());
-				Sample*       dst = buffer ();
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
-			}
-		}
+		return mix_connections (_buffer, n_samples);
 	}
 	return _buffer;
 }
@@ -1262,11 +1242,9 @@ void* PulseMidiPort::get_buffer (pframes_t /*n_samples*/)
 {
 	if (is_input ()) {
 		_buffer.clear ();
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		for (std::set<BackendPortPtr>::const_iterator i = connections.begin ();
-		     i != connections.end ();
-		     ++i) {
-			const PulseMidiBuffer* src = boost::dynamic_pointer_cast<PulseMidiPort> (*i)->const_buffer ();
+		boost::shared_ptr<ConnectionList> cl = connection_list ();
+		for (ConnectionList::const_iterator i = cl->begin (); i != cl->end (); ++i) {
+			const PulseMidiBuffer* src = static_cast<PulseMidiPort*> (*i)->const_buffer ();
 			for (PulseMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
 				_buffer.push_back (*it);
 			}
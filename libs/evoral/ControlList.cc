@@ -65,6 +65,7 @@ ControlList::ControlList (const Parameter& id, const ParameterDescriptor& desc)
 	, _desc(desc)
 	, _interpolation (default_interpolation ())
 	, _curve(0)
+	, _event_arrays_valid (false)
 {
 	_frozen = 0;
 	_changed_when_thawed = false;
@@ -86,6 +87,7 @@ ControlList::ControlList (const ControlList& other)
 	, _desc(other._desc)
 	, _interpolation(other._interpolation)
 	, _curve(0)
+	, _event_arrays_valid (false)
 {
 	_frozen = 0;
 	_changed_when_thawed = false;
@@ -108,6 +110,7 @@ ControlList::ControlList (const ControlList& other, double start, double end)
 	, _desc(other._desc)
 	, _interpolation(other._interpolation)
 	, _curve(0)
+	, _event_arrays_valid (false)
 {
 	_frozen = 0;
 	_changed_when_thawed = false;
@@ -230,10 +233,34 @@ ControlList::maybe_signal_changed ()
 	if (_frozen) {
 		_changed_when_thawed = true;
 	} else {
+		if (!_event_arrays_valid && !_in_write_pass) {
+			Glib::Threads::RWLock::WriterLock lm (_lock);
+			unlocked_update_event_arrays ();
+		}
 		Dirty (); /* EMIT SIGNAL */
 	}
 }
 
+void
+ControlList::unlocked_update_event_arrays ()
+{
+	if (_event_arrays_valid || _frozen || _sort_pending) {
+		return;
+	}
+
+	_event_times.clear ();
+	_event_values.clear ();
+	_event_times.reserve (_events.size ());
+	_event_values.reserve (_events.size ());
+
+	for (const_iterator i = _events.begin (); i != _events.end (); ++i) {
+		_event_times.push_back ((*i)->when);
+		_event_values.push_back ((*i)->value);
+	}
+
+	_event_arrays_valid = true;
+}
+
 void
 ControlList::clear ()
 {
@@ -500,6 +527,11 @@ ControlList::write_pass_finished (double /*when*/, double thinning_factor)
 	}
 	new_write_pass = true;
 	_in_write_pass = false;
+
+	if (!_event_arrays_valid) {
+		Glib::Threads::RWLock::WriterLock lm (_lock);
+		unlocked_update_event_arrays ();
+	}
 }
 
 void
@@ -1140,6 +1172,7 @@ ControlList::thaw ()
 void
 ControlList::mark_dirty () const
 {
+	_event_arrays_valid = false;
 	_lookup_cache.left = -1;
 	_lookup_cache.range.first = _events.end();
 	_lookup_cache.range.second = _events.end();
@@ -1369,6 +1402,10 @@ ControlList::unlocked_eval (double x) const
 		}
 	}
 
+	if (_event_arrays_valid) {
+		return event_arrays_eval (x);
+	}
+
 	switch (npoints) {
 	case 0:
 		return _desc.normal;
@@ -1418,6 +1455,53 @@ ControlList::unlocked_eval (double x) const
 	return _desc.normal;
 }
 
+double
+ControlList::event_arrays_eval (double x) const
+{
+	const size_t npoints = _event_times.size ();
+
+	if (npoints == 0) {
+		return _desc.normal;
+	}
+
+	if (npoints == 1 || x <= _event_times.front ()) {
+		return _event_values.front ();
+	}
+
+	if (x >= _event_times.back ()) {
+		return _event_values.back ();
+	}
+
+	/* first point at or after x, x is known to be inside the list */
+	const size_t u = lower_bound (_event_times.begin (), _event_times.end (), x) - _event_times.begin ();
+
+	if (_event_times[u] == x) {
+		/* x is a control point in the data */
+		return _event_values[u];
+	}
+
+	const double lpos = _event_times[u - 1];
+	const double lval = _event_values[u - 1];
+	const double upos = _event_times[u];
+	const double uval = _event_values[u];
+
+	const double fraction = (double) (x - lpos) / (double) (upos - lpos);
+
+	switch (_interpolation) {
+		case Discrete:
+			return lval;
+		case Logarithmic:
+			return interpolate_logarithmic (lval, uval, fraction, _desc.lower, _desc.upper);
+		case Exponential:
+			return interpolate_gain (lval, uval, fraction, _desc.upper);
+		case Curved:
+			/* only used x-fade curves, never direct eval */
+			assert (0);
+		default: // Linear
+			return interpolate_linear (lval, uval, fraction);
+	}
+}
+
 double
 ControlList::multipoint_eval (double x) const
 {
@@ -354,22 +354,104 @@ Curve::_get_vector (double x0, double x1, float *vec, int32_t veclen) const
 		return;
 	}
 
+	double dx = 0;
+	if (veclen > 1) {
+		dx = (hx - lx) / (veclen - 1);
+	}
+
+	if (_list.has_event_arrays () && _list.interpolation() != ControlList::Curved && dx >= 0) {
+		multipoint_fill (lx, dx, vec, veclen);
+		return;
+	}
+
 	if (_dirty) {
 		solve ();
 	}
 
 	rx = lx;
 
-	double dx = 0;
-	if (veclen > 1) {
-		dx = (hx - lx) / (veclen - 1);
-	}
-
 	for (i = 0; i < veclen; ++i, rx += dx) {
 		vec[i] = multipoint_eval (rx);
 	}
 }
 
+/** Equivalent to calling multipoint_eval() for every sample, but
+ * using a binary search of the list's event arrays for the first
+ * sample only, then advancing the segment as x increases.
+ */
+void
+Curve::multipoint_fill (double lx, double dx, float *vec, int32_t veclen) const
+{
+	const std::vector<double>& when  = _list.event_times ();
+	const std::vector<double>& value = _list.event_values ();
+	const size_t npoints = when.size ();
+
+	/* first point at or after lx */
+	size_t u = lower_bound (when.begin(), when.end(), lx) - when.begin();
+	double rx = lx;
+
+	for (int32_t i = 0; i < veclen; ) {
+
+		while (u < npoints && when[u] < rx) {
+			++u;
+		}
+
+		if (u == npoints) {
+			/* we're after the last point */
+			for (; i < veclen; ++i) {
+				vec[i] = value.back();
+			}
+			return;
+		}
+
+		if (when[u] == rx) {
+			/* rx is a control point in the data */
+			vec[i++] = value[u];
+			rx += dx;
+			continue;
+		}
+
+		if (u == 0) {
+			/* we're before the first point */
+			vec[i++] = value.front();
+			rx += dx;
+			continue;
+		}
+
+		/* fill all samples before the next control point */
+		const double before = value[u - 1];
+		const double vdelta = value[u] - before;
+		const double bwhen  = when[u - 1];
+		const double trange = when[u] - bwhen;
+		const double next   = when[u];
+
+		if (vdelta == 0.0 || _list.interpolation() == ControlList::Discrete) {
+			for (; i < veclen && rx < next; ++i, rx += dx) {
+				vec[i] = before;
+			}
+			continue;
+		}
+
+		switch (_list.interpolation()) {
+			case ControlList::Logarithmic:
+				for (; i < veclen && rx < next; ++i, rx += dx) {
+					vec[i] = interpolate_logarithmic (before, value[u], (rx - bwhen) / trange, _list.descriptor().lower, _list.descriptor().upper);
+				}
+				break;
+			case ControlList::Exponential:
+				for (; i < veclen && rx < next; ++i, rx += dx) {
+					vec[i] = interpolate_gain (before, value[u], (rx - bwhen) / trange, _list.descriptor().upper);
+				}
+				break;
+			default: // Linear
+				for (; i < veclen && rx < next; ++i, rx += dx) {
+					vec[i] = before + (vdelta * ((rx - bwhen) / trange));
+				}
+				break;
+		}
+	}
+}
+
 double
 Curve::multipoint_eval (double x) const
 {
@@ -752,19 +752,6 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 			DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1\terasing note #%2 %3 @ %4\n", this, (*i)->id(), (int)(*i)->note(), (*i)->time()));
 			_notes.erase (i);
 
-			if (note->note() == _lowest_note || note->note() == _highest_note) {
-
-				_lowest_note = 127;
-				_highest_note = 0;
-
-				for (typename Sequence<Time>::Notes::iterator ii = _notes.begin(); ii != _notes.end(); ++ii) {
-					if ((*ii)->note() < _lowest_note)
-						_lowest_note = (*ii)->note();
-					if ((*ii)->note() > _highest_note)
-						_highest_note = (*ii)->note();
-				}
-			}
-
 			erased = true;
 			break;
 		}
@@ -792,19 +779,6 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 				DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1\tID-based pass, erasing note #%2 %3 @ %4\n", this, (*i)->id(), (int)(*i)->note(), (*i)->time()));
 				_notes.erase (i);
 
-				if (note->note() == _lowest_note || note->note() == _highest_note) {
-
-					_lowest_note = 127;
-					_highest_note = 0;
-
-					for (typename Sequence<Time>::Notes::iterator ii = _notes.begin(); ii != _notes.end(); ++ii) {
-						if ((*ii)->note() < _lowest_note)
-							_lowest_note = (*ii)->note();
-						if ((*ii)->note() > _highest_note)
-							_highest_note = (*ii)->note();
-					}
-				}
-
 				erased = true;
 				id_matched = true;
 				break;
@@ -836,13 +810,14 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 		} else {
 
 			/* Now find the same note in the "pitches" list (which indexes
-			 * notes by channel+time. We care only about its note number
-			 * so the search_note has all other properties unset.
+			 * notes by channel+note-number+time. We care only about its
+			 * note number and time so the search_note has all other
+			 * properties unset.
 			 */
 
-			NotePtr search_note (new Note<Time>(0, Time(), Time(), note->note(), 0));
+			NotePtr search_note (new Note<Time>(0, note->time(), Time(), note->note(), 0));
 
-			for (j = p.lower_bound (search_note); j != p.end() && (*j)->note() == note->note(); ++j) {
+			for (j = p.lower_bound (search_note); j != p.end() && (*j)->note() == note->note() && (*j)->time() == note->time(); ++j) {
 
 				if ((*j) == note) {
 					DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1\terasing pitch %2 @ %3\n", this, (int)(*j)->note(), (*j)->time()));
@@ -856,6 +831,10 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 			warning << string_compose ("erased note %1 not found in pitches for channel %2", *note, (int) note->channel()) << endmsg;
 		}
 
+		if (note->note() == _lowest_note || note->note() == _highest_note) {
+			update_note_range ();
+		}
+
 		_edited = true;
 
 	} else {
@@ -1143,10 +1122,10 @@ bool
 Sequence<Time>::contains_unlocked (const NotePtr& note) const
 {
 	const Pitches& p (pitches (note->channel()));
-	NotePtr search_note(new Note<Time>(0, Time(), Time(), note->note()));
+	NotePtr search_note(new Note<Time>(0, note->time(), Time(), note->note()));
 
 	for (typename Pitches::const_iterator i = p.lower_bound (search_note);
-	     i != p.end() && (*i)->note() == note->note(); ++i) {
+	     i != p.end() && (*i)->note() == note->note() && (*i)->time() == note->time(); ++i) {
 
 		if (**i == *note) {
 			return true;
@@ -1156,6 +1135,25 @@ Sequence<Time>::contains_unlocked (const NotePtr& note) const
 	return false;
 }
 
+/** Update the lowest and highest note number, caller must hold write lock */
+template<typename Time>
+void
+Sequence<Time>::update_note_range ()
+{
+	_lowest_note = 127;
+	_highest_note = 0;
+
+	for (uint8_t c = 0; c < 16; ++c) {
+		const Pitches& p (_pitches[c]);
+		if (p.empty()) {
+			continue;
+		}
+		/* pitches are sorted by note number */
+		_lowest_note = std::min (_lowest_note, (*p.begin())->note());
+		_highest_note = std::max (_highest_note, (*p.rbegin())->note());
+	}
+}
+
 template<typename Time>
 bool
 Sequence<Time>::overlaps (const NotePtr& note, const NotePtr& without) const
@@ -1172,7 +1170,7 @@ Sequence<Time>::overlaps_unlocked (const NotePtr& note, const NotePtr& without)
 	Time ea  = note->end_time();
 
 	const Pitches& p (pitches (note->channel()));
-	NotePtr search_note(new Note<Time>(0, Time(), Time(), note->note()));
+	NotePtr search_note(new Note<Time>(0, std::numeric_limits<Time>::lowest(), Time(), note->note()));
 
 	for (typename Pitches::const_iterator i = p.lower_bound (search_note);
 	     i != p.end() && (*i)->note() == note->note(); ++i) {
@@ -1184,6 +1182,11 @@ Sequence<Time>::overlaps_unlocked (const NotePtr& note, const NotePtr& without)
 		Time sb = (*i)->time();
 		Time eb = (*i)->end_time();
 
+		if (sb > ea) {
+			/* this and all later notes of this pitch start after the given note */
+			break;
+		}
+
 		if (((sb > sa) && (eb <= ea)) ||
 		    ((eb >= sa) && (eb <= ea)) ||
 		    ((sb > sa) && (sb <= ea)) ||
@@ -1299,6 +1302,10 @@ template<typename Time>
 void
 Sequence<Time>::get_notes_by_pitch (Notes& n, NoteOperator op, uint8_t val, int chan_mask) const
 {
+	/* first and last possible note with the given number */
+	NotePtr search_note(new Note<Time>(0, std::numeric_limits<Time>::lowest(), Time(), val, 0));
+	NotePtr after_note(new Note<Time>(0, std::numeric_limits<Time>::max(), Time(), val, 0));
+
 	for (uint8_t c = 0; c < 16; ++c) {
 
 		if (chan_mask != 0 && !((1<<c) & chan_mask)) {
@@ -1306,44 +1313,38 @@ Sequence<Time>::get_notes_by_pitch (Notes& n, NoteOperator op, uint8_t val, int
 		}
 
 		const Pitches& p (pitches (c));
-		NotePtr search_note(new Note<Time>(0, Time(), Time(), val, 0));
 		typename Pitches::const_iterator i;
+		typename Pitches::const_iterator e;
 		switch (op) {
 		case PitchEqual:
 			i = p.lower_bound (search_note);
-			while (i != p.end() && (*i)->note() == val) {
-				n.insert (*i);
-			}
+			e = p.upper_bound (after_note);
 			break;
 		case PitchLessThan:
-			i = p.upper_bound (search_note);
-			while (i != p.end() && (*i)->note() < val) {
-				n.insert (*i);
-			}
+			i = p.begin ();
+			e = p.lower_bound (search_note);
 			break;
 		case PitchLessThanOrEqual:
-			i = p.upper_bound (search_note);
-			while (i != p.end() && (*i)->note() <= val) {
-				n.insert (*i);
-			}
+			i = p.begin ();
+			e = p.upper_bound (after_note);
 			break;
 		case PitchGreater:
-			i = p.lower_bound (search_note);
-			while (i != p.end() && (*i)->note() > val) {
-				n.insert (*i);
-			}
+			i = p.upper_bound (after_note);
+			e = p.end ();
 			break;
 		case PitchGreaterThanOrEqual:
 			i = p.lower_bound (search_note);
-			while (i != p.end() && (*i)->note() >= val) {
-				n.insert (*i);
-			}
+			e = p.end ();
 			break;
 
 		default:
 			//fatal << string_compose (_("programming error: %1 %2", X_("get_notes_by_pitch() called with illegal operator"), op)) << endmsg;
 			abort(); /* NOTREACHED*/
 		}
+
+		for (; i != e; ++i) {
+			n.insert (*i);
+		}
 	}
 }
 
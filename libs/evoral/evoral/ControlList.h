@@ -25,6 +25,7 @@
 
 #include <cassert>
 #include <list>
+#include <vector>
 #include <stdint.h>
 
 #include <boost/pool/pool.hpp>
@@ -286,6 +287,14 @@ public:
 	/** @return the list of events */
 	const EventList& events() const { return _events; }
 
+	/** @return true if event_times() and event_values() are a
+	 * (sorted) copy of the current events. Must hold the lock.
+	 */
+	bool has_event_arrays () const { return _event_arrays_valid; }
+
+	const std::vector<double>& event_times () const { return _event_times; }
+	const std::vector<double>& event_values () const { return _event_values; }
+
 	// FIXME: const violations for Curve
 	Glib::Threads::RWLock& lock()       const { return _lock; }
 	LookupCache& lookup_cache() const { return _lookup_cache; }
@@ -360,6 +369,11 @@ protected:
 	/** Called by unlocked_eval() to handle cases of 3 or more control points. */
 	double multipoint_eval (double x) const;
 
+	/** Binary search version of unlocked_eval(), using the event arrays */
+	double event_arrays_eval (double x) const;
+
+	void unlocked_update_event_arrays ();
+
 	void build_search_cache_if_necessary (double start) const;
 
 	boost::shared_ptr<ControlList> cut_copy_clear (double, double, int op);
@@ -388,6 +402,14 @@ protected:
 
 	Curve* _curve;
 
+	/* Contiguous copy of the event list, used for lookup when
+	 * the list is not being modified. Invalidated by mark_dirty(),
+	 * and updated (under the write lock) when changes are signalled.
+	 */
+	std::vector<double>   _event_times;
+	std::vector<double>   _event_values;
+	mutable bool          _event_arrays_valid;
+
 private:
 	iterator   most_recent_insert_iterator;
 	double     insert_position;
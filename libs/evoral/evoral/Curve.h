@@ -44,6 +44,7 @@ private:
 	double multipoint_eval (double x) const;
 
 	void _get_vector (double x0, double x1, float *arg, int32_t veclen) const;
+	void multipoint_fill (double lx, double dx, float *arg, int32_t veclen) const;
 
 	mutable bool       _dirty;
 	const ControlList& _list;
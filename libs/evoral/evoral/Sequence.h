@@ -123,10 +123,16 @@ public:
 		return a->time() < b->time();
 	}
 
+	/** Orders notes by note number, and notes with the same number by time,
+	 * so that a given note can be found in O(log N).
+	 */
 	struct NoteNumberComparator {
 		inline bool operator()(const boost::shared_ptr< const Note<Time> > a,
 		                       const boost::shared_ptr< const Note<Time> > b) const {
-			return a->note() < b->note();
+			if (a->note() != b->note()) {
+				return a->note() < b->note();
+			}
+			return a->time() < b->time();
 		}
 	};
 
@@ -338,6 +344,7 @@ private:
 
 	bool overlaps_unlocked (const NotePtr& ev, const NotePtr& ignore_this_note) const;
 	bool contains_unlocked (const NotePtr& ev) const;
+	void update_note_range ();
 
 	void append_note_on_unlocked(const Event<Time>& event, Evoral::event_id_t);
 	void append_note_off_unlocked(const Event<Time>& event);
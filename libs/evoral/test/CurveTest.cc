@@ -293,6 +293,61 @@ CurveTest::ctrlListEval ()
 	CPPUNIT_ASSERT_EQUAL(9.0, cl->unlocked_eval(999.));
 }
 
+void
+CurveTest::eventArrays ()
+{
+	float vec[1024];
+	float ref[1024];
+
+	boost::shared_ptr<Evoral::ControlList> cl = TestCtrlList();
+	boost::shared_ptr<Evoral::ControlList> lst = TestCtrlList();
+
+	cl->create_curve ();
+	lst->create_curve ();
+
+	/* thaw() signals the change and updates the arrays,
+	 * lst is only modified without signalling a change
+	 */
+	cl->freeze ();
+	for (int i = 0; i < 1000; ++i) {
+		const double v = (i % 7) * .25 + (i % 3);
+		cl->fast_simple_add (i * 10.0, v);
+		lst->fast_simple_add (i * 10.0, v);
+	}
+	cl->thaw ();
+
+	CPPUNIT_ASSERT (cl->has_event_arrays ());
+	CPPUNIT_ASSERT (!lst->has_event_arrays ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1000, cl->event_times ().size ());
+
+	for (int is = 0; is < 2; ++is) {
+		const ControlList::InterpolationStyle style = is ? ControlList::Discrete : ControlList::Linear;
+		cl->set_interpolation (style);
+		lst->set_interpolation (style);
+
+		for (double x = -5.0; x < 10020.0; x += 2.5) {
+			CPPUNIT_ASSERT_EQUAL (lst->unlocked_eval (x), cl->unlocked_eval (x));
+		}
+
+		cl->curve ().get_vector (15.0, 9000.0, vec, 1024);
+		lst->curve ().get_vector (15.0, 9000.0, ref, 1024);
+		for (int i = 0; i < 1024; ++i) {
+			CPPUNIT_ASSERT_EQUAL (ref[i], vec[i]);
+		}
+
+		/* exactly on control points */
+		cl->curve ().get_vector (100.0, 1123.0, vec, 1024);
+		lst->curve ().get_vector (100.0, 1123.0, ref, 1024);
+		for (int i = 0; i < 1024; ++i) {
+			CPPUNIT_ASSERT_EQUAL (ref[i], vec[i]);
+		}
+	}
+
+	/* any modification invalidates the arrays */
+	cl->fast_simple_add (10000.0, 1.0);
+	CPPUNIT_ASSERT (!cl->has_event_arrays ());
+}
+
 void
 CurveTest::constrainedCubic ()
 {
@@ -134,6 +134,58 @@ SequenceTest::iteratorSeekTest ()
 	CPPUNIT_ASSERT(i == j);
 }
 
+void
+SequenceTest::noteLookupTest ()
+{
+	typedef Sequence<Time>::Notes SeqNotes;
+
+	seq->clear();
+
+	for (Notes::const_iterator i = test_notes.begin(); i != test_notes.end(); ++i) {
+		seq->add_note_unlocked(*i);
+	}
+
+	// a second note with the pitch of an existing one, earlier in time
+	boost::shared_ptr< Note<Time> > dup (new Note<Time>(0, Time(50), Time(10), 70, 64));
+	seq->add_note_unlocked(dup);
+
+	CPPUNIT_ASSERT_EQUAL((uint8_t)64, seq->lowest_note());
+	CPPUNIT_ASSERT_EQUAL((uint8_t)75, seq->highest_note());
+
+	SeqNotes n;
+	seq->get_notes(n, Sequence<Time>::PitchEqual, 70);
+	CPPUNIT_ASSERT_EQUAL(size_t(2), n.size());
+
+	n.clear();
+	seq->get_notes(n, Sequence<Time>::PitchLessThan, 70);
+	CPPUNIT_ASSERT_EQUAL(size_t(6), n.size());
+
+	n.clear();
+	seq->get_notes(n, Sequence<Time>::PitchLessThanOrEqual, 70);
+	CPPUNIT_ASSERT_EQUAL(size_t(8), n.size());
+
+	n.clear();
+	seq->get_notes(n, Sequence<Time>::PitchGreater, 70);
+	CPPUNIT_ASSERT_EQUAL(size_t(5), n.size());
+
+	n.clear();
+	seq->get_notes(n, Sequence<Time>::PitchGreaterThanOrEqual, 70);
+	CPPUNIT_ASSERT_EQUAL(size_t(7), n.size());
+
+	CPPUNIT_ASSERT(seq->contains(dup));
+	CPPUNIT_ASSERT(seq->contains(test_notes[6]));
+
+	// removing the outermost notes updates the range
+	seq->remove_note_unlocked(test_notes.front());
+	seq->remove_note_unlocked(test_notes.back());
+	CPPUNIT_ASSERT_EQUAL((uint8_t)65, seq->lowest_note());
+	CPPUNIT_ASSERT_EQUAL((uint8_t)74, seq->highest_note());
+
+	seq->remove_note_unlocked(dup);
+	CPPUNIT_ASSERT(!seq->contains(dup));
+	CPPUNIT_ASSERT(seq->contains(test_notes[6]));
+}
+
 void
 SequenceTest::controlInterpolationTest ()
 {